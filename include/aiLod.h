@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// how often an enemy re-plans, by distance to the player
+enum class AiRate : uint8_t {
+    Near, // every tick
+    Mid,  // every Config::AiLod::MID_INTERVAL ticks, staggered by index
+    Far   // round-robin slices, at most the far budget per tick
+};
+
+// enemy AI work of the last finished tick
+struct AiLodStats {
+    int nearCount = 0;
+    int midCount = 0;
+    int farCount = 0;
+    int thinks = 0;        // enemies that re-planned, every rate
+    int farThinks = 0;     // far enemies that re-planned, never above farBudget
+    int farBudget = 0;
+    int farSweepTicks = 0; // ticks for the slices to visit every far enemy once
+};
+
+// Update-rate LOD for the enemy AI. Thinking (flow field sample and crowd
+// steering) runs at a rate picked by distance; on the other ticks an enemy
+// keeps moving along its last heading.
+class AiLod {
+public:
+    // farDistance: the far rate starts there, usually the fog end
+    static void BeginFrame(float farDistance);
+    static void EndFrame();
+
+    static AiRate Classify(float distance);
+    // whether enemy index re-plans this tick. An enemy without a heading yet
+    // plans on its first tick, except in the far band where it takes a share
+    // of the far budget and waits for a later tick once the budget is spent
+    static bool ShouldThink(size_t index, float distance, bool hasHeading = true);
+
+    static void SetFarBudget(int budget);
+    static int GetFarBudget() { return farBudget; }
+    static const AiLodStats& GetStats() { return stats; }
+
+private:
+    AiLod() { }
+
+    static uint64_t tick;
+    static float farDistance;
+    static int farBudget;
+    static int farCursor;    // far ordinal the current slice starts at
+    static int lastFarCount; // far enemies of the previous tick, the ring size
+    static AiLodStats current;
+    static AiLodStats stats;
+};
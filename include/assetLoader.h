@@ -0,0 +1,80 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "mesh.h"
+
+class Shader;
+class TextRenderer;
+
+typedef uint32_t AssetHandle; // 0 is never a valid handle
+
+enum class AssetState {
+    Unknown,
+    Loading,  // queued or being decoded on a worker
+    Ready,    // uploaded, the resource is in the ResourceManager
+    Failed
+};
+
+// Background loading: workers parse models, decode images and rasterize fonts,
+// the GL objects are created on the main thread by ProcessUploads/Wait.
+class AssetLoader {
+public:
+    // 0 workers: one less than the hardware threads, at least one
+    static void Start(unsigned int workerCount = 0);
+    // joins the workers, drops what was not uploaded: those handles fail
+    static void Shutdown();
+
+    // requests are deduplicated by name while they are in flight
+    static AssetHandle LoadModelAsync(std::string file, std::string name, Shader* shader,
+                                      GeometryRetention retention = GeometryRetention::Release);
+    static AssetHandle LoadTextureAsync(std::string file, std::string name);
+    static AssetHandle LoadFontAsync(TextRenderer* renderer, std::string font, unsigned int fontSize);
+
+    static AssetState GetState(AssetHandle handle);
+    static AssetHandle Find(const std::string& name); // in-flight request for name, 0 if none
+
+    // main thread only: runs finished uploads until budgetMs is spent (at least one),
+    // returns how many ran
+    static int ProcessUploads(double budgetMs);
+    // main thread only: uploads until handle is done, false if it failed
+    static bool Wait(AssetHandle handle);
+    static void WaitAll();
+
+    static size_t PendingCount(); // requests not uploaded yet
+
+private:
+    AssetLoader() { }
+
+    struct Upload {
+        AssetHandle handle;
+        std::string name;
+        std::function<bool()> run; // GL work, returns false on failure
+    };
+
+    static std::vector<std::thread> workers;
+    static std::deque<std::function<void()>> jobs;
+    static std::mutex jobMutex;
+    static std::condition_variable jobReady;
+    static bool stopping;
+
+    static std::deque<Upload> uploads;
+    static std::mutex uploadMutex;
+    static std::condition_variable uploadReady;
+
+    // handle states and in-flight names, main thread only
+    static std::vector<AssetState> states;
+    static std::map<std::string, AssetHandle> inFlight;
+
+    static AssetHandle request(const std::string& name, std::function<std::function<bool()>()> decode);
+    static void workerLoop();
+    static void finish(Upload& upload);
+};
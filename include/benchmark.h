@@ -0,0 +1,20 @@
+#pragma once
+
+// Offline measurements run from the command line, without a window or GL
+// context (e.g. "./main --bench-crowd").
+class Benchmark {
+public:
+    // crowd steering at 100, 1000 and 10000 enemies: uniform grid against
+    // the all-pairs check enemy capsule contacts used to cost, nonzero when
+    // the two disagree
+    static int Crowd();
+    // CPU cost of a horde frame (update at the AiLod rates, hits, instance
+    // matrices) up to Config::Horde::MAX_ENEMIES ghosts
+    static int Horde();
+    // chi-square check of LootTable::Sample against the drop probabilities
+    // of every enemy tier, nonzero when a tier's frequencies do not fit
+    static int Loot();
+
+private:
+    Benchmark() { }
+};
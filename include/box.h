@@ -1,6 +1,7 @@
 #pragma once
 
 #include "shape.h"
+#include "primitiveCache.h"
 #include <vector>
 
 class Box : public Shape {
@@ -11,8 +12,10 @@ public:
     virtual Shape* clone() const override {
         return new Box(*this);
     }
+    DrawGeometry getGeometry() const override {
+        return DrawGeometry{ geometry->VAO, static_cast<GLsizei>(geometry->num_indices), GL_UNSIGNED_INT, glm::vec3(w, h, d) * 2.0f };
+    }
+
 private:
-    unsigned int num_indices;
-    GLuint VAO;
-    GLuint buffers[2];
+    std::shared_ptr<const PrimitiveGeometry> geometry; // unit cube, scaled by the full dimensions
 };
\ No newline at end of file
@@ -33,6 +33,7 @@ public:
     glm::mat4 GetViewMatrix();
     glm::mat4 GetProjectionMatrix(float aspectRatio);
     void ProcessMouseMovement(float xoffset, float yoffset, bool constrainPitch = true);
+    void SetOrientation(float yaw, float pitch); // exact angles, for replays
     void ProcessKeyboard(Camera_Movement direction, float deltaTime);
     void UpdatePhysics(float deltaTime) override; // Override to custom handle or disable gravity
     void SetTarget(glm::vec3 newTarget);
@@ -1,6 +1,7 @@
 #pragma once
 #include "shape.h"
 #include "shader.h"
+#include "primitiveCache.h"
 
 class Capsule : public Shape {
 public:
@@ -11,8 +12,10 @@ public:
     }
     float radius;
     float height;
+    DrawGeometry getGeometry() const override {
+        return DrawGeometry{ geometry->VAO, static_cast<GLsizei>(geometry->num_indices), GL_UNSIGNED_INT, glm::vec3(radius) };
+    }
+
 private:
-    unsigned int num_indices;
-    GLuint VAO;
-    GLuint buffers[2];
+    std::shared_ptr<const PrimitiveGeometry> geometry; // radius 1, scaled by radius
 };
\ No newline at end of file
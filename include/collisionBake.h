@@ -0,0 +1,32 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// static box collider of the map, in world space
+struct CollisionBox {
+    std::string name;
+    glm::vec3 center;
+    glm::vec3 size;
+};
+
+// Collision primitives baked from the collision model into a small binary
+// file in CACHE_DIR. The map loads only that file, the collision model is
+// imported (CPU only, never uploaded) when the bake is missing or stale.
+class CollisionBake {
+public:
+    static const uint32_t Version = 1;
+
+    // baked boxes of sourcePath, baking them first when needed
+    static bool Get(const std::string& sourcePath, std::vector<CollisionBox>& boxes);
+
+    static std::string BakePathFor(const std::string& sourcePath);
+    static bool Load(const std::string& sourcePath, std::vector<CollisionBox>& boxes);
+    static bool Build(const std::string& sourcePath, std::vector<CollisionBox>& boxes);
+    static bool Write(const std::string& sourcePath, const std::vector<CollisionBox>& boxes);
+
+private:
+    CollisionBake() { }
+};
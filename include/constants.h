@@ -53,11 +53,59 @@ namespace Config {
         constexpr glm::vec3 COLOR = glm::vec3(0.9f, 0.1f, 0.1f);
     }
 
+    namespace Projectile {
+        constexpr int SPHERE_SLICES = 20;
+        constexpr int POOL_CAPACITY = 256; // projectiles in flight at once, extra shots are dropped
+    }
+
     namespace EnemySpawner {
         constexpr float SPAWN_INTERVAL = 2.0f;
         constexpr float SPAWN_RADIUS = 15.0f;
 
         constexpr int MAX_ENEMIES = 40;
+        constexpr int PREWARM_PER_TIER = 10; // pooled enemies built by Game::Init
+    }
+
+    namespace Navigation {
+        constexpr float CELL_SIZE = 1.0f;     // flow field resolution on the XZ plane
+        constexpr float STEP_HEIGHT = 0.5f;   // colliders lower than this above the floor do not block
+        constexpr int CELLS_PER_FRAME = 4096; // wave expansion budget when the player changes cell
+    }
+
+    namespace Crowd {
+        constexpr float NEIGHBOUR_RADIUS = 1.2f;    // grid cell size, cohesion looks this far
+        constexpr float SEPARATION_DISTANCE = 0.8f; // a bit more than two enemy radii
+        constexpr float SEPARATION_WEIGHT = 1.5f;
+        constexpr float COHESION_WEIGHT = 0.1f;
+        constexpr int MAX_NEIGHBOURS = 16;          // bounds the cost in a packed crowd
+    }
+
+    namespace AiLod {
+        constexpr float NEAR_DISTANCE = 12.0f; // closer enemies re-plan every tick
+        constexpr int MID_INTERVAL = 4;        // ticks between plans up to the fog end
+        constexpr int FAR_BUDGET = 256;        // far enemies re-planned per tick
+    }
+
+    namespace Horde {
+        constexpr int MAX_ENEMIES = 10000;
+        constexpr float SPAWN_PER_SECOND = 150.0f;
+        constexpr float SPAWN_MIN_RADIUS = 20.0f;
+        constexpr float SPAWN_MAX_RADIUS = 40.0f;
+        constexpr int ENEMIES_TO_WIN = 5000;
+        constexpr float LOOT_CHANCE = 0.05f;      // share of kills that roll the loot table
+        constexpr float ATTACK_MARGIN = 0.1f;     // reach beyond touching the player
+        constexpr float PROJECTILE_RADIUS = 0.2f; // hit radius of a shot against ghosts
+        constexpr float QUERY_MARGIN = 0.2f;      // covers one frame of ghost movement
+    }
+
+    namespace Loading {
+        constexpr double UPLOAD_BUDGET_MS = 2.0; // GL uploads per frame for streamed assets
+        constexpr double LOADING_SCREEN_BUDGET_MS = 12.0; // uploads per loading screen frame
+    }
+
+    namespace Headless {
+        constexpr float STEP = 1.0f / 60.0f;        // virtual seconds per frame unless --step is given
+        constexpr unsigned long REPORT_FRAMES = 3600; // frames per progress line of a soak run
     }
 
     namespace StatsMenu {
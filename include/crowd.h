@@ -0,0 +1,56 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+// Boids-style steering for the enemy crowd. Positions are bucketed in a
+// uniform grid on the XZ plane (hashed, the world is unbounded), so each
+// enemy only looks at the 3x3 cells around it: O(n) per frame instead of
+// the O(n^2) capsule contacts between enemies.
+class Crowd {
+public:
+    // buckets the positions steered this frame, index i is enemy i. They are
+    // read in place, not copied: the caller keeps them alive until the next
+    // Build, and a point moved in between stays in the bucket of its old cell
+    static void Build(const glm::vec3* positions, size_t count);
+
+    // separation from close neighbours plus a weak pull to the local centre,
+    // on the XZ plane, length at most about 1. Only the
+    // Config::Crowd::MAX_NEIGHBOURS closest neighbours count, ties broken by
+    // index, so the result does not depend on the bucket order.
+    static glm::vec3 Steering(size_t index);
+
+    // same result by checking every other enemy, for the benchmark
+    static glm::vec3 SteeringBruteForce(size_t index);
+
+    // snapshot indices on the XZ plane within radius of position, radius at
+    // most Config::Crowd::NEIGHBOUR_RADIUS
+    static void Query(glm::vec3 position, float radius, std::vector<uint32_t>& out);
+
+    static size_t Count() { return pointCount; }
+
+private:
+    Crowd() { }
+
+    static const glm::vec3* points;
+    static size_t pointCount;
+    static std::vector<uint32_t> cellStart; // bucket b holds entries [cellStart[b], cellStart[b + 1])
+    static std::vector<uint32_t> entries;
+    // scratch of the counting sort, kept between frames
+    static std::vector<uint32_t> pointBuckets;
+    static std::vector<uint32_t> cursors;
+    static uint32_t bucketMask;
+
+    struct Neighbour {
+        float distanceSq;
+        uint32_t index;
+    };
+
+    static glm::ivec2 cellOf(glm::vec3 position);
+    static uint32_t bucketOf(int x, int z);
+    static int nearbyBuckets(glm::vec3 position, uint32_t buckets[9]);
+    static bool closer(const Neighbour& a, const Neighbour& b);
+    static void consider(size_t index, size_t other, Neighbour* nearest, int& count);
+    static glm::vec3 steer(size_t index, Neighbour* nearest, int count);
+};
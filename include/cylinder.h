@@ -11,6 +11,10 @@ public:
         return new Cylinder(*this);
     }
 
+    DrawGeometry getGeometry() const override {
+        return DrawGeometry{ VAO, static_cast<GLsizei>(num_indices), GL_UNSIGNED_INT };
+    }
+
 private:
     unsigned int num_indices;
     GLuint VAO;
@@ -9,7 +9,15 @@ public:
     Enemy(Shape* shape = nullptr, glm::vec3 position = glm::vec3(0.0f), Shader* projectileShader = nullptr);
     ~Enemy();
     void attack(Player* player, float deltaTime);
-    void moveTowardsPlayer(glm::vec3 playerPosition, float deltaTime, bool isAffraid=false);
+    // steering: Crowd separation/cohesion, added to the path direction
+    void moveTowardsPlayer(glm::vec3 playerPosition, float deltaTime, bool isAffraid=false, glm::vec3 steering=glm::vec3(0.0f));
+    // moveTowardsPlayer in two steps: think re-plans the heading, advance
+    // moves along it, every tick even when AiLod skips the plan
+    void think(glm::vec3 playerPosition, bool isAffraid, glm::vec3 steering);
+    void advance(float deltaTime) { Position += heading * speed * deltaTime; }
+    bool hasHeading() const { return heading != glm::vec3(0.0f); }
+    // unit-or-shorter heading of a ghost at position, shared with the Horde
+    static glm::vec3 ChaseDirection(glm::vec3 position, glm::vec3 playerPosition, bool isAffraid, glm::vec3 steering);
 
     void setModel(Node* modelNode);
     void draw(glm::mat4& view, glm::mat4& projection) override;
@@ -25,6 +33,10 @@ public:
 
     float getHealth() const { return health; }
     void setHealth(int newHealth) { health = newHealth; }
+    void setMaxHealth(int newMaxHealth) { maxHealth = newMaxHealth; health = newMaxHealth; }
+
+    // back to a fresh spawn of the same tier, used when recycled by the EnemyPool
+    void Reset(glm::vec3 position);
     
     void takeDamage(int damage);
     bool isAlive() const { return health > 0; }
@@ -37,6 +49,7 @@ public:
     float getRarityCoefficient() const { return baseRarityCoeff / ((float)tier); }
 private:
     int health;
+    int maxHealth;
     int power;
     int defensePower;
     float speed;
@@ -46,5 +59,6 @@ private:
     float experienceReward;
     float baseRarityCoeff = 1.2f;
     Node* model = nullptr;
+    glm::vec3 heading = glm::vec3(0.0f); // last planned direction, zero until the first plan
 
  };
\ No newline at end of file
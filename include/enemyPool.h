@@ -0,0 +1,39 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <vector>
+
+class Enemy;
+class Node;
+
+// Per-tier free lists of Enemy objects. A released enemy keeps its capsule,
+// its model instance and its scene/physics registration, it is only disabled,
+// so spawning and killing allocate nothing once the pool is warm.
+class EnemyPool {
+public:
+    static const int TierCount = 4;
+
+    static void Init(Node* sceneRoot);
+    // creates count parked enemies of the tier ahead of time
+    static void Prewarm(int tier, int count);
+
+    // reset enemy of the tier at position, created only when the tier's list is empty
+    static Enemy* Acquire(int tier, glm::vec3 position);
+    static void Release(Enemy* enemy);
+
+    // deletes the parked enemies, active ones stay with their owner
+    static void Clear();
+
+    static size_t FreeCount(int tier);
+    static size_t CreatedCount(int tier); // enemies built for the tier so far
+
+private:
+    EnemyPool() { }
+
+    static int slot(int tier);
+    static Enemy* create(int tier);
+
+    static Node* sceneRoot;
+    static std::vector<Enemy*> freeLists[TierCount];
+    static size_t created[TierCount];
+};
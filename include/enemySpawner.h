@@ -2,14 +2,17 @@
 #include "enemy.h"
 #include "physicShapeObject.h"
 #include "node.h"
+#include "random.h"
 
 class EnemySpawner : public PhysicShapeObject {
     public:
-        EnemySpawner(Node* sceneRoot, glm::vec3 position, std::vector<Enemy*>& enemyList);
+        // seed: spawns are a reproducible function of the session seed
+        EnemySpawner(Node* sceneRoot, glm::vec3 position, std::vector<Enemy*>& enemyList, uint64_t seed);
         
         void SpawnEnemy();
 
         void Update(float deltaTime);
+        void Reset() { timeSinceLastSpawn = 0.0f; } // new run, the next spawn waits a full interval
 
         void static updateSpawnProbabilities(int playerLevel);
 
@@ -18,6 +21,7 @@ class EnemySpawner : public PhysicShapeObject {
     private:
         inline static int enemyCount = 0;
         inline static std::vector<float> spawnProbabilities = {1.0f, 0.0f, 0.00f, 0.0f};
+        Random random;
         float timeSinceLastSpawn;
         Node* sceneRoot;
         std::vector<Enemy*>& enemyList;
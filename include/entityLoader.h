@@ -11,9 +11,10 @@ class EntityLoader {
 public:
 
     static Player* CreatePlayer(glm::vec3 position);
-    static Projectile* CreateProjectile(glm::vec3 pos, glm::vec3 dir, Player* shooter);
+    static Projectile* CreateProjectile(); // disabled shell owned by the ProjectilePool
+    static void LaunchProjectile(Projectile* proj, glm::vec3 pos, glm::vec3 dir, Player* shooter);
     static Enemy* CreateEnemy(glm::vec3 position,int tier);
     static PhysicShapeObject* CreateTestBox(glm::vec3 position);
-    static EnemySpawner* CreateEnemySpawner(Node* sceneRoot, glm::vec3 position, std::vector<Enemy*>& enemyList);
+    static EnemySpawner* CreateEnemySpawner(Node* sceneRoot, glm::vec3 position, std::vector<Enemy*>& enemyList, uint64_t seed);
     static PhysicShapeObject* Boulder(glm::vec3 position, float scale, float mass);
 };
\ No newline at end of file
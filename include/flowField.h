@@ -0,0 +1,66 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "collisionBake.h"
+
+// Shared pathfinding for the enemies: the map colliders are rasterized once
+// into a navigation grid on the XZ plane, and a breadth-first wave from the
+// player's cell gives every walkable cell the direction of its shortest path.
+// An enemy samples its cell in O(1), so pathing costs the same for 10 or
+// 10000 enemies.
+class FlowField {
+public:
+    // rasterizes the colliders, boxes rising above the floor block their cells
+    static void Build(const std::vector<CollisionBox>& boxes);
+    static void Clear();
+
+    // expands the wave by at most Config::Navigation::CELLS_PER_FRAME cells.
+    // A finished wave is published for Sample, and the next one starts from
+    // the player's cell if it changed. Sample keeps reading the last finished
+    // field meanwhile, so a cell change never leaves enemies without a path.
+    static void Update(glm::vec3 playerPosition);
+
+    // unit XZ direction towards the player at position, from the last
+    // finished wave. False when the grid cannot answer (outside, unreachable,
+    // or the cell that wave started from). In a
+    // blocked cell (an enemy grazing an inflated wall) it points at the
+    // adjacent walkable cell closest to the player, or out of the obstacle.
+    static bool Sample(glm::vec3 position, glm::vec2& direction);
+
+    static bool IsBuilt() { return !blocked.empty(); }
+    static bool IsComplete() { return frontier.empty(); } // the wave in progress covers every reachable cell
+
+private:
+    FlowField() { }
+
+    static constexpr uint8_t NoDirection = 0xFF;
+
+    static glm::vec2 origin; // world XZ of the corner of cell (0, 0)
+    static int width, depth;
+    static std::vector<uint8_t> blocked;
+    static std::vector<uint8_t> escape; // blocked cells: towards the nearest walkable cell
+
+    // the wave in progress, distances are valid only when their stamp matches
+    static std::vector<uint32_t> distance;
+    static std::vector<uint32_t> stamp;
+    static std::vector<uint8_t> directions; // index in the neighbour table
+    static uint32_t wave;
+    static std::deque<int> frontier;
+    static int targetCell;
+    static bool published; // the wave in progress is finished and copied below
+
+    // the last finished wave, what Sample reads
+    static std::vector<uint32_t> sampledDistance; // UINT32_MAX where unreached
+    static std::vector<uint8_t> sampledDirections;
+    static int sampledTarget;
+
+    static int cellAt(glm::vec3 position);
+    static bool walkable(int x, int z);
+    static void expand(int cell);
+    static void buildEscape();
+    static void publish();
+};
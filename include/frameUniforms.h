@@ -0,0 +1,50 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+// std140 mirror of the FrameData block declared in the lit shaders
+struct FrameData {
+    glm::mat4 view;
+    glm::mat4 projection;
+    glm::mat4 lightSpaceMatrix;
+    glm::vec4 viewPos;   // xyz = camera position
+    glm::vec4 fogColor;
+    glm::vec4 fogRange;  // x = start, y = end
+    glm::vec4 sunPos;    // xyz = directional light position
+    GLint isShadowPass;
+    GLint padding[3];
+};
+
+// Per-frame uniforms shared by every lit program through one uniform
+// buffer. Each render pass owns a slot of the buffer; all slots are
+// uploaded once per frame and the active one is bound with a range.
+class FrameUniforms {
+public:
+    static const GLuint BindingPoint = 0;
+
+    enum Pass {
+        ShadowPass = 0,
+        MainPass,
+        PassCount
+    };
+
+    static void Init();
+
+    // fog is owned by the game, the viewer fills the rest per pass
+    static void SetFog(const glm::vec4& color, float start, float end);
+    static void SetPass(Pass pass, const glm::mat4& view, const glm::mat4& projection,
+                        const glm::mat4& lightSpaceMatrix, const glm::vec3& viewPos, const glm::vec3& sunPos);
+
+    static void Upload();
+    static void Bind(Pass pass);
+
+private:
+    FrameUniforms() { }
+
+    static GLuint ubo;
+    static GLsizeiptr slotSize; // sizeof(FrameData) rounded up to the offset alignment
+    static FrameData passes[PassCount];
+    static glm::vec4 fogColor;
+    static glm::vec4 fogRange;
+};
@@ -13,38 +13,52 @@
 #include "constants.h"
 #include "textRenderer.h"
 #include "statsMenu.h"
+#include "random.h"
+
+enum class GameMode {
+    Classic, // Enemy objects, up to Config::EnemySpawner::MAX_ENEMIES
+    Horde    // thousands of ghosts in the data-oriented Horde store
+};
 
 class Game {
 public:
-    Game(Viewer* viewer);
+    // every random stream of the session derives from seed, a recorded
+    // session replays identically with the same seed
+    Game(Viewer* viewer, GameMode mode, uint64_t seed);
     ~Game();
 
-    void Init();
+    void Init();     // loads the world once per session
+    void StartRun(); // per-run state and props
+    void ResetRun(); // restart in place, keeps every loaded asset
     
     void Update();
     void RenderUI();
     void RenderDeathUI();
     void RenderWinUI();
+    void RenderLoadingUI(float progress); // presents a frame on its own
     
     Player* getPlayer() const { return player; }
     bool getHasWon() const { return hasWon; }
+    int getEnemyKilled() const { return enemyKilled; }
+    size_t getEnemyCount() const; // alive in either enemy store
     void setHasWon(bool won) { hasWon = won; }
 
     void ProcessInput(float deltaTime);
     void ProcessGameOverInput();
-
-	std::map<std::string, double> getLootTableProbabilities(float alpha);
   
 private:
     Viewer* viewer;
+    GameMode mode;
+    int enemiesToWin;
     Sprite* spriteRenderer;
     TextRenderer* textRenderer;
 
     Player* player = nullptr;
     StatsMenu* statsMenu;
     std::vector<Enemy*> enemies;
-    EnemySpawner* enemySpawner;
-    Map* map;
+    std::vector<glm::vec3> crowdPositions; // reused every frame for Crowd::Build
+    EnemySpawner* enemySpawner = nullptr; // classic mode only
+    Map* map = nullptr;
     Crosshair* crosshair;
     HandlePhysics* handlePhysics;
 
@@ -61,10 +75,6 @@ private:
     float fogStart;
     float fogEnd;
 
-    GLint fogColorLocation;
-    GLint fogStartLocation;
-    GLint fogEndLocation;
-
     glm::vec3 skyColor;
 
     int enemyKilled;
@@ -72,7 +82,10 @@ private:
 
     double resetGameTime = 0.0;
 
-    std::map<std::string, float> lootTable{ {"", 1.0f}, {"DamageBoost", 4.0f }, {"SpeedBoost", 2.0f}, {"HealthPack", 2.5f},{"Fear", 5.5f} };
+    Random lootRandom; // drops, and the seeds of the spawner and the horde
+
+    // score, fog and loot of one kill, from either enemy store
+    void onEnemyKilled(glm::vec3 position, float rarity, float experience, bool rollLoot = true);
 
 
 };
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <chrono>
+
+// Simulation time for gameplay. The windowed game follows the wall clock,
+// the headless mode runs on a virtual clock that advances a fixed step per
+// frame, however long the frame actually took.
+class GameClock {
+public:
+    // step > 0: virtual clock, every Tick is exactly step seconds
+    // step == 0: wall clock (the default)
+    static void SetFixedStep(float step);
+    static float GetFixedStep() { return fixedStep; }
+    static bool IsVirtual() { return fixedStep > 0.0f; }
+
+    // starts a frame: advances the clock and returns the frame's delta time
+    static float Tick();
+    // starts a frame of exactly step seconds, a replay feeds the recorded ones
+    static float Advance(float step);
+
+    // the sum of the frame delta times so far, the same value for a whole frame;
+    // a replay of the same delta times sees exactly the same times
+    static double Now() { return now; }
+    static float DeltaTime() { return deltaTime; }
+
+private:
+    GameClock() { }
+
+    static float fixedStep;
+    static double now;
+    static float deltaTime;
+    static std::chrono::steady_clock::time_point lastWall;
+};
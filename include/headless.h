@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "game.h"
+
+// Runs the game without a window or GL context (NullRenderer), as fast as
+// the CPU allows, and prints the update cost per frame, so long sessions can
+// be soak tested and the simulation measured on machines without a display.
+class Headless {
+public:
+    // scripted play on the virtual GameClock (e.g. "./main --headless 216000"
+    // is an hour at 60 Hz); a run that ends in death or victory restarts in
+    // place, ESCAPE in the script stops
+    static int Run(GameMode mode, unsigned long frames, float step, const std::string& scriptPath, uint64_t seed);
+    // replays an InputLog recording frame for frame, game overs included
+    static int Replay(const std::string& logPath);
+
+private:
+    Headless() { }
+
+    // tick starts a frame (input and clock), false stops the run
+    static int simulate(Viewer& viewer, Game& game, unsigned long frames, bool restartRuns,
+                        const std::function<bool(unsigned long)>& tick);
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+// Reports frames in which a resource was loaded on the gameplay hot path
+// (synchronous imports, texture decodes, GL geometry built on first use).
+class HitchDetector {
+public:
+    // loads are only hitches once gameplay runs, Game::Init turns this off while it loads
+    static void SetHotPath(bool hotPath);
+    static bool IsHotPath() { return hotPath; }
+
+    static void NoteLoad(const std::string& what, double ms);
+    // called once per frame after the swap, logs the frame if it loaded anything
+    static void EndFrame(double frameMs);
+
+    static unsigned int HitchCount() { return hitchCount; }
+
+private:
+    HitchDetector() { }
+
+    struct Load {
+        std::string what;
+        double ms;
+    };
+
+    static bool hotPath;
+    static unsigned long frameIndex;
+    static unsigned int hitchCount;
+    static std::vector<Load> frameLoads;
+};
+
+// times a load for the HitchDetector, nested scopes only count the outermost
+class LoadScope {
+public:
+    explicit LoadScope(std::string what);
+    ~LoadScope();
+
+    LoadScope(const LoadScope&) = delete;
+    LoadScope& operator=(const LoadScope&) = delete;
+
+private:
+    std::string what;
+    std::chrono::steady_clock::time_point start;
+    static int depth;
+};
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+#include "random.h"
+
+class Node;
+class Projectile;
+class Shape;
+
+// a ghost removed by the last Horde::ApplyHits, rewarded by the Game
+struct HordeDeath {
+    glm::vec3 position;
+    float rarity;     // loot rarity coefficient, as Enemy::getRarityCoefficient
+    float experience;
+};
+
+// Horde mode: up to Config::Horde::MAX_ENEMIES ghosts kept as parallel
+// arrays instead of Enemy objects. Ghosts have no physics body: Update moves
+// the whole horde in one pass (flow field, crowd steering, attacks),
+// projectiles are tested against the crowd grid, dead ghosts are
+// swap-removed, and each tier is drawn with one instanced batch per mesh.
+class Horde {
+public:
+    static const int TierCount = 4;
+
+    // per-tier meshes from the ghost models, and the draw hook in the scene
+    static void Init(Node* sceneRoot, uint64_t seed);
+    static void Clear(); // every ghost goes, for a new run
+    static void Shutdown(); // Clear, then frees the tier meshes Init built
+
+    static bool Spawn(int tier, glm::vec3 position); // false when the horde is full
+
+    // Config::Horde::SPAWN_PER_SECOND new ghosts in a ring around the target
+    static void SpawnAround(float deltaTime, glm::vec3 target);
+    // moves and separates the horde, returns the damage dealt to the target
+    static float Update(float deltaTime, glm::vec3 target, bool isAffraid);
+    // damages the ghosts touched by the projectiles, then removes the dead
+    static void ApplyHits(const std::vector<Projectile*>& projectiles);
+    static const std::vector<HordeDeath>& Deaths() { return deaths; }
+
+    static size_t Count() { return positions.size(); }
+
+    // model matrices of every ghost, grouped by tier, rebuilt once per frame
+    static void BuildInstances();
+    // queues the horde for the current pass, both passes share the matrices
+    static void Submit(glm::mat4& view, glm::mat4& projection);
+
+private:
+    Horde() { }
+
+    // one mesh of a tier's ghost model, relative to the ghost
+    struct Part {
+        Shape* shape;
+        glm::mat4 local;
+    };
+
+    // structure of arrays, index i is the same ghost in each
+    static std::vector<glm::vec3> positions;
+    static std::vector<glm::vec3> headings; // last plan, followed between AiLod plans
+    static std::vector<glm::vec2> facings;
+    static std::vector<float> health;
+    static std::vector<float> cooldowns;
+    static std::vector<uint8_t> tiers;
+    static std::vector<uint32_t> ids; // stable across swap-removes, for the pierced lists
+    static uint32_t nextId;
+
+    static std::vector<HordeDeath> deaths;
+    static std::vector<Part> parts[TierCount];
+    static Node* ghostNodes[TierCount]; // owns the parts, null for a fallback capsule
+    static std::vector<glm::mat4> instances[TierCount];
+    static bool instancesDirty;
+
+    static float spawnBudget;
+    static Random random;
+    static std::vector<uint32_t> hits; // scratch for the projectile queries
+
+    static void remove(size_t index);
+    static void collectParts(Node* node, const glm::mat4& parent, std::vector<Part>& out);
+};
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+class Viewer;
+enum class GameMode;
+
+// Input and delta time of every frame of a session, in a compact binary
+// file. With the session seed and the same frames the simulation takes the
+// same path, so a recorded fight replays exactly, e.g. as a benchmark.
+// A frame is its delta time, one bit per key and, only when the camera
+// turned, its yaw and pitch: 6 or 14 bytes.
+class InputLog {
+public:
+    ~InputLog();
+
+    // starts recording, the header keeps what the replay must start from
+    bool Record(const std::string& path, uint64_t seed, GameMode mode);
+    // reads a recording for replay, false if it is missing or not a recording
+    bool Load(const std::string& path);
+
+    // starts a frame in place of GameClock::Tick and returns its delta time.
+    // Recording: ticks the clock and writes the input the frame starts with.
+    // Replay: applies the next recorded input to the keymap and the camera and
+    // advances the clock by the recorded delta time; past the last frame the
+    // live input and the wall clock take over.
+    float Tick(Viewer& viewer);
+
+    bool IsRecording() const { return file.is_open(); }
+    bool Finished() const { return next >= frames.size(); }
+
+    uint64_t Seed() const { return seed; }
+    GameMode Mode() const;
+    size_t FrameCount() const { return IsRecording() ? next : frames.size(); }
+
+private:
+    struct Frame {
+        float deltaTime;
+        uint16_t keys;
+        float yaw;   // carried over from the last frame that turned
+        float pitch;
+    };
+
+    std::ofstream file;
+    std::vector<Frame> frames;
+    size_t next = 0; // frame to replay, or frames written
+    uint64_t seed = 0;
+    uint8_t mode = 0;
+
+    // orientation written last, a frame that keeps it stores no angles
+    float lastYaw = 0.0f;
+    float lastPitch = 0.0f;
+    bool hasOrientation = false;
+};
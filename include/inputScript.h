@@ -0,0 +1,39 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+class Viewer;
+
+struct InputEvent {
+    enum class Type { Press, Release, Look };
+
+    unsigned long frame;
+    Type type;
+    int key = 0;         // GLFW key or mouse button, Press and Release
+    float dx = 0.0f;     // mouse offsets, Look
+    float dy = 0.0f;
+};
+
+// Keyboard and mouse input for runs without a window, read from a text file:
+//   <frame> press   <key>
+//   <frame> release <key>
+//   <frame> look    <dx> <dy>
+//   loop <frames>
+// keys are W A S D SPACE FIRE V R F ESCAPE. With a loop the events replay
+// every <frames> frames, so a short script drives an arbitrarily long run.
+class InputScript {
+public:
+    // replaces the events with the file content, false if it can't be opened
+    bool Load(const std::string& path);
+
+    // applies the events of frame to the viewer's keymap and camera
+    void Apply(unsigned long frame, Viewer& viewer) const;
+
+    const std::vector<InputEvent>& Events() const { return events; }
+    unsigned long LoopFrames() const { return loopFrames; }
+
+private:
+    std::vector<InputEvent> events; // sorted by frame
+    unsigned long loopFrames = 0;   // 0: the script plays once
+};
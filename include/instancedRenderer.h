@@ -0,0 +1,60 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <map>
+#include <tuple>
+#include <vector>
+
+#include "shader.h"
+#include "shape.h"
+
+// per-instance data streamed to the instance buffer
+struct InstanceData {
+    glm::mat4 model;
+    glm::vec4 colorAlpha; // rgb = color, a = alpha
+};
+
+// Groups shapes sharing the same geometry and material flags and draws
+// each group with a single glDrawElementsInstanced call.
+class InstancedRenderer {
+public:
+    static bool Enabled;
+
+    static void Init(Shader* shader);
+
+    // queue a shape for the current pass, returns false if it can't be instanced
+    static bool Submit(const Shape* shape, const glm::mat4& model);
+    // queue count copies of a shape at models[i] * local with one batch lookup
+    static bool SubmitMany(const Shape* shape, const glm::mat4* models, size_t count, const glm::mat4& local = glm::mat4(1.0f));
+
+    // draw every queued group then empty the queue (batches are kept for reuse)
+    static void Flush(bool shadowPass);
+
+    static int GetDrawCallCount() { return drawCalls; }
+    static int GetInstanceCount() { return instanceCount; }
+
+private:
+    InstancedRenderer() { }
+
+    // (VAO, emissive, transparent)
+    typedef std::tuple<GLuint, bool, bool> BatchKey;
+
+    struct Batch {
+        DrawGeometry geometry;
+        bool emissive;
+        bool transparent;
+        std::vector<InstanceData> instances;
+    };
+
+    static Shader* shader;
+    static GLuint instanceVBO;
+    static std::vector<Batch> batches;
+    static std::map<BatchKey, size_t> batchIndex;
+    static int drawCalls;
+    static int instanceCount;
+
+    // batch of the shape's geometry, nullptr if the shape can't be instanced
+    static Batch* batchFor(const Shape* shape, DrawGeometry& geometry);
+    static void drawBatch(Batch& batch);
+};
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "random.h"
+#include "statusEffect.h"
+
+enum class LootItem : uint8_t {
+    None,
+    DamageBoost,
+    SpeedBoost,
+    HealthPack,
+    Fear,
+    Count
+};
+
+struct LootInfo {
+    const char* name;  // pickup name, as read by Player::AddPickup
+    float weight;      // rarer with a higher weight
+    glm::vec3 color;
+    float lifetime;    // effect duration in seconds, 0 for instant items
+    StatusEffect effect; // granted on pickup, looked up by name, None for instant items
+};
+
+// Vose alias table: O(1) sampling of a discrete distribution
+class AliasTable {
+public:
+    void Build(const double* probabilities, size_t count);
+    size_t Sample(Random& random) const;
+
+private:
+    std::vector<float> threshold;
+    std::vector<uint32_t> alias;
+};
+
+// Enemy drops. The probability of an item is exp(-rarity * weight),
+// normalized over all entries, "None" included. One alias table is built per
+// rarity coefficient the first time it is seen.
+class LootTable {
+public:
+    static const size_t ItemCount = static_cast<size_t>(LootItem::Count);
+
+    static const LootInfo& Info(LootItem item);
+
+    // probabilities of every item for a rarity coefficient, summing to 1
+    static void Probabilities(float rarity, double out[ItemCount]);
+
+    static LootItem Sample(float rarity, Random& random);
+
+private:
+    LootTable() { }
+
+    static const LootInfo items[ItemCount];
+    static std::vector<std::pair<float, AliasTable>> tables;
+};
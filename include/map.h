@@ -3,16 +3,12 @@
 #include "node.h"
 #include "physicShapeObject.h"
 #include "box.h"
+#include "collisionBake.h"
 
 class Map {
 public:
     Map(Shader* shader, Node* sceneRoot);
 
 private:
-    void CreateCollisionFromNode(
-        Node* node,
-        Shader* shader,
-        Node* sceneRoot,
-        const glm::mat4& parentTransform
-    );
+    void CreateCollisionBox(const CollisionBox& box, Shader* shader);
 };
\ No newline at end of file
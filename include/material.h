@@ -0,0 +1,34 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+typedef uint16_t MaterialID;
+
+struct Material {
+    std::string pattern; // fragment searched in the imported material name
+    glm::vec3 color;
+};
+
+// Material table loaded from a data file. Imported material names are
+// resolved to an ID once at load time, draws only index the table.
+class MaterialTable {
+public:
+    static const MaterialID DefaultMaterial = 0;
+
+    // replaces the table with the entries of the file, keeps the default on failure
+    static bool Load(const std::string& path);
+
+    // first entry whose pattern appears in the name, DefaultMaterial otherwise
+    static MaterialID Resolve(const std::string& materialName);
+
+    static const Material& Get(MaterialID id) { return materials[id]; }
+    static size_t Size() { return materials.size(); }
+
+private:
+    MaterialTable() { }
+
+    static std::vector<Material> materials;
+};
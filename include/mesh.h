@@ -1,11 +1,13 @@
 #pragma once
 
-#include <glad/glad.h> 
+#include <glad/glad.h>
 #include <glm/glm.hpp>
+#include <memory>
 #include <string>
 #include <vector>
 #include "shape.h"
 #include "shader.h"
+#include "material.h"
 
 // data struct
 struct Vertex {
@@ -21,23 +23,96 @@ struct Texture {
     std::string path;
 };
 
-class Mesh : public Shape {
+// what happens to the CPU copy of the geometry once it is on the GPU
+enum class GeometryRetention {
+    Keep,    // keep vertices/indices, needed for collision or bounds queries
+    Release  // drop them after upload, only the AABB stays resident
+};
+
+// GPU vertex format picked per mesh at load, standard.vert only reads
+// position and normal so tangents are never uploaded
+struct VertexLayout {
+    bool quantizedPositions; // snorm16 against the mesh bounds, float otherwise
+    bool hasTexCoords;       // half-float UVs, only for textured meshes
+    GLenum indexType;        // GL_UNSIGNED_SHORT below 65536 vertices
+    GLsizei stride;
+};
+
+// a mesh in its GPU format, packed once at import and stored as is in the
+// model cache, so a cache hit uploads the mapped bytes without touching them
+struct PackedGeometry {
+    VertexLayout layout;
+    glm::vec3 positionOffset;
+    float positionScale;
+    glm::vec3 aabbMin;
+    glm::vec3 aabbMax;
+    uint32_t vertexCount = 0;
+    uint32_t indexCount = 0;
+    const unsigned char* vertexBytes = nullptr; // vertexCount * layout.stride
+    const unsigned char* indexBytes = nullptr;  // 16 or 32 bits each, see layout.indexType
+};
+
+// immutable geometry uploaded once and shared by every instance of a mesh
+class MeshData {
 public:
     // data
     std::vector<Vertex>       vertices;
     std::vector<unsigned int> indices;
     std::vector<Texture>      textures;
     unsigned int VAO;
-    std::string materialName; 
+    std::string materialName;
+    MaterialID materialID; // index in the MaterialTable, resolved at load
+
+    // kept even when the CPU arrays are released
+    unsigned int vertexCount;
+    unsigned int indexCount;
+    glm::vec3 aabbMin;
+    glm::vec3 aabbMax;
+
+    // packed GPU format, quantized positions are decoded by the draw transform
+    VertexLayout layout;
+    glm::vec3 positionOffset;
+    float positionScale;
 
     // builder
-    Mesh(std::vector<Vertex> vertices, std::vector<unsigned int> indices, std::vector<Texture> textures, Shader* shader, std::string matName);
+    MeshData(std::vector<Vertex> vertices, std::vector<unsigned int> indices, std::vector<Texture> textures, std::string matName,
+             MaterialID materialID, GeometryRetention retention = GeometryRetention::Keep);
+    // uploads already packed geometry straight from caller memory (e.g. a mapped
+    // cache file); the source arrays are copied only when kept
+    MeshData(const PackedGeometry& packed, const Vertex* vertices, const unsigned int* indices, std::string matName,
+             MaterialID materialID, GeometryRetention retention = GeometryRetention::Keep);
+    ~MeshData();
 
-    void draw(glm::mat4& model, glm::mat4& view, glm::mat4& projection) override;
-    virtual Shape* clone() const override;
+    // picks the layout of a mesh and packs it, the bytes go to the two storage vectors
+    static void Pack(const Vertex* vertices, size_t vertexCount, const unsigned int* indices, size_t indexCount, bool hasTexCoords,
+                     PackedGeometry& out, std::vector<unsigned char>& vertexStorage, std::vector<unsigned char>& indexStorage);
+
+    bool hasCpuData() const { return !vertices.empty(); }
+    size_t residentBytes() const; // CPU memory held by this mesh
+    size_t gpuBytes() const;      // size of the uploaded vertex/index buffers
+    DrawGeometry geometry() const;
+
+    // owns GL buffers, never copied
+    MeshData(const MeshData&) = delete;
+    MeshData& operator=(const MeshData&) = delete;
 
 private:
     unsigned int VBO, EBO;
 
-    void setupMesh();
-};
\ No newline at end of file
+    void upload(const PackedGeometry& packed);
+};
+
+// lightweight per-instance draw component referencing shared geometry
+class Mesh : public Shape {
+public:
+    std::shared_ptr<const MeshData> data;
+
+    // builder
+    Mesh(std::shared_ptr<const MeshData> data, Shader* shader);
+
+    void draw(glm::mat4& model, glm::mat4& view, glm::mat4& projection) override;
+    virtual Shape* clone() const override;
+
+    DrawGeometry getGeometry() const override;
+    glm::vec3 getColor() const override;
+};
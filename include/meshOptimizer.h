@@ -0,0 +1,21 @@
+#pragma once
+
+#include <vector>
+#include "mesh.h"
+
+// Import-time index and vertex reordering. Runs once per mesh while the
+// model is loaded, the draw path is untouched.
+class MeshOptimizer {
+public:
+    // reorder triangles for the post-transform vertex cache (Forsyth)
+    static void OptimizeVertexCache(std::vector<unsigned int>& indices, size_t vertexCount);
+
+    // reorder vertices by first use and remap the indices accordingly
+    static void OptimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices);
+
+    // average cache miss ratio: transformed vertices per triangle with a FIFO cache
+    static float ComputeACMR(const std::vector<unsigned int>& indices, size_t vertexCount, unsigned int cacheSize = 32);
+
+private:
+    MeshOptimizer() { }
+};
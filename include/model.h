@@ -10,25 +10,47 @@
 #include "mesh.h"
 #include "shader.h"
 #include "node.h"
+#include "modelCache.h"
 
 class Model {
 public:
     Node* rootNode;
 
     // builder
-    Model(std::string const &path, Shader* shader);
+    Model(std::string const &path, Shader* shader, GeometryRetention retention = GeometryRetention::Release);
+    // GL half of a load, data comes from LoadData (possibly on another thread)
+    Model(const ModelData& data, Shader* shader, GeometryRetention retention = GeometryRetention::Release);
+    ~Model();
+
+    // the model owns its node tree, copies go through clone
+    Model(const Model&) = delete;
+    Model& operator=(const Model&) = delete;
+
+    // CPU half of a load: cache or assimp import, touches no GL state
+    static bool LoadData(std::string const &path, ModelData& data);
 
     void Draw(glm::mat4& model, glm::mat4& view, glm::mat4& projection);
 
     Model* clone(Shader* shader);
 
+    // memory accounting, summed over every mesh of the hierarchy
+    size_t residentGeometryBytes() const;
+    size_t gpuGeometryBytes() const;
+
 private:
     Shader* shader;
     std::string directory;
+    GeometryRetention retention;
+
+    // empty model, clone fills in the node tree
+    Model(Shader* shader, std::string directory, GeometryRetention retention);
+
+    Node* buildNodes(const ModelData& data);
 
-    void loadModel(std::string const &path);
-    Node* processNode(aiNode *node, const aiScene *scene);
-    Mesh* processMesh(aiMesh *mesh, const aiScene *scene);
+    // assimp import into ModelData, only when the cache can't be used
+    static bool importModel(std::string const &path, ModelData& data);
+    static void processNode(aiNode *node, const aiScene *scene, ModelData& data, int32_t parent, std::vector<int32_t>& meshRecords);
+    static uint32_t processMesh(aiMesh *mesh, const aiScene *scene, ModelData& data);
     
-    glm::mat4 aiMatrix4x4ToGlm(const aiMatrix4x4& from);
+    static glm::mat4 aiMatrix4x4ToGlm(const aiMatrix4x4& from);
 };
\ No newline at end of file
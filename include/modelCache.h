@@ -0,0 +1,85 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "mesh.h"
+
+// Read-only view of a whole file, memory-mapped where the platform allows it.
+class MappedFile {
+public:
+    MappedFile() { }
+    ~MappedFile();
+
+    bool open(const std::string& path);
+    void close();
+
+    const unsigned char* data() const { return bytes; }
+    size_t size() const { return length; }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+private:
+    const unsigned char* bytes = nullptr;
+    size_t length = 0;
+    bool mapped = false;                // false when the file was read into fallback
+    std::vector<unsigned char> fallback;
+};
+
+// processed mesh, the arrays point into ModelData storage or into a mapped cache file
+struct MeshRecord {
+    std::string name;
+    std::string materialName;
+    const Vertex* vertices = nullptr; // source arrays, for CPU users (collision, kept geometry)
+    uint32_t vertexCount = 0;
+    const unsigned int* indices = nullptr;
+    uint32_t indexCount = 0;
+    PackedGeometry packed;            // GPU format, what gets uploaded
+};
+
+struct NodeRecord {
+    std::string name;
+    glm::mat4 transform;
+    int32_t parent;               // -1 for the root, parents come before their children
+    std::vector<uint32_t> meshes; // indices in ModelData::meshes
+};
+
+// CPU side of an imported model, filled by assimp or by the binary cache
+struct ModelData {
+    std::vector<NodeRecord> nodes;
+    std::vector<MeshRecord> meshes;
+
+    // owned arrays of imported meshes, unused when loaded from the cache
+    std::vector<std::vector<Vertex>> vertexStorage;
+    std::vector<std::vector<unsigned int>> indexStorage;
+    std::vector<std::vector<unsigned char>> packedStorage; // vertex then index bytes of each mesh
+
+    // keeps the cache file mapped while the meshes are uploaded
+    MappedFile mapping;
+};
+
+// Versioned binary cache of processed models (hierarchy, transforms, material
+// names, optimized vertices and indices, and each mesh packed in its GPU
+// layout), stored in CACHE_DIR. A cache entry is
+// stale when the format version or the source file size or date changed.
+class ModelCache {
+public:
+    static const uint32_t Version = 2; // bump whenever import processing or packing changes
+
+    static std::string CachePathFor(const std::string& sourcePath);
+
+    // maps the cache of sourcePath, false if missing, stale or malformed
+    static bool Load(const std::string& sourcePath, ModelData& out);
+
+    static bool Write(const std::string& sourcePath, const ModelData& data);
+
+    // size and modification time used to detect stale derived files
+    static bool SourceStamp(const std::string& sourcePath, uint64_t& size, int64_t& time);
+
+private:
+    ModelCache() { }
+};
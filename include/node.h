@@ -19,6 +19,7 @@ public:
     void remove(PhysicShapeObject* pso);
 	void recursiveRemove(PhysicShapeObject* pso);
     void draw(glm::mat4& model, glm::mat4& view, glm::mat4& projection);
+    void submitInstances(glm::mat4& model, glm::mat4& view, glm::mat4& projection); // queue shapes on the instanced path
     void set_transform(const glm::mat4 &transform); // sets local transform
     std::vector<Node *> children_;
     const std::vector<Shape*>& getShapes() const;
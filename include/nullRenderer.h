@@ -0,0 +1,16 @@
+#pragma once
+
+// GL backend for runs without a window: every GL entry point the engine
+// calls is pointed at a no-op, so shaders, meshes and textures are "created"
+// (object names are handed out) and draws do nothing. Installed instead of
+// gladLoadGLLoader, there is no context to query.
+class NullRenderer {
+public:
+    static void Install();
+    static bool IsInstalled() { return installed; }
+
+private:
+    NullRenderer() { }
+
+    static bool installed;
+};
@@ -57,7 +57,7 @@ enum CollisionGroup : uint32_t {
     CG_PRESETS_MAP = CG_PLAYER | CG_ENEMY | CG_PLAYER_PROJECTILE | CG_ENEMY_PROJECTILE | CG_PROP,
 	CG_PRESETS_PROP = CG_ENVIRONMENT | CG_PLAYER | CG_ENEMY | CG_PLAYER_PROJECTILE | CG_ENEMY_PROJECTILE | CG_PROP,
     CG_PRESETS_PLAYER = CG_ENVIRONMENT | CG_ENEMY | CG_ENEMY_PROJECTILE | CG_PROP | CG_PICKUP,
-	CG_PRESETS_ENEMY = CG_ENEMY | CG_PLAYER | CG_PLAYER_PROJECTILE,
+	CG_PRESETS_ENEMY = CG_PLAYER | CG_PLAYER_PROJECTILE, // enemies keep apart through Crowd steering
 	CG_PRESETS_PICKUP = CG_PLAYER,
 };
 
@@ -104,6 +104,7 @@ public:
     uint32_t  collisionGroup = CG_NONE;
     uint32_t  collisionMask = CG_NONE;
     bool deleteOnReset = false;
+    bool enabled = true; // false while parked in a pool: no physics, collisions or drawing
 
     // Update physics state (Integration only)
     virtual void UpdatePhysics(float deltaTime);
@@ -22,6 +22,9 @@ public:
 	// The shape representing the object.
 	Shape* shape; // May be nullptr.
 
+	// If true, the shape is queued in the InstancedRenderer instead of drawn directly.
+	bool instanced = false;
+
 	// Draw the object using its shape.
 	virtual void draw(glm::mat4& view, glm::mat4& projection); // Uses PhysicObject's Position and orientation, doesn't do any physics update.
 };
\ No newline at end of file
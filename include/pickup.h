@@ -1,6 +1,7 @@
 #pragma once
 
 #include "physicShapeObject.h"
+#include "statusEffect.h"
 
 class Pickup : public PhysicShapeObject {
 	public:
@@ -8,6 +9,7 @@ class Pickup : public PhysicShapeObject {
 		~Pickup() {};
 
 		float lifetime = -1.0f; // seconds
+		StatusEffect effect = StatusEffect::None; // None: instant item, resolved by name
 		bool toBeDeleted = false;
 
 		void BeforeCollide(PhysicObject* other, CollisionInfo info, float deltaTime) override;
@@ -7,6 +7,7 @@
 #include "node.h"
 #include "pickup.h"
 #include "enemy.h"
+#include "statusEffect.h"
 #include <map>
 
 
@@ -50,7 +51,7 @@ public:
     void resize(float scale);
 
     // projectile setter/getter
-    std::vector<Projectile*> getActiveProjectiles() const { return activeProjectiles; }
+    const std::vector<Projectile*>& getActiveProjectiles() const { return activeProjectiles; }
     float getProjectileSpeed() const { return projectileSpeed; }
     // attack getter/setter
     float getAttackDamage() const { return attackDamage; }
@@ -76,8 +77,6 @@ public:
 	void BeforeCollide(PhysicObject* other, CollisionInfo info, float deltaTime) override;
 	void OnCollide(PhysicObject* other, CollisionInfo info, float deltaTime) override;
 
-    void deleteActiveProjectile(Projectile* proj);
-
     void levelUp();
 
     void resetPlayerState(glm::vec3 startPosition);
@@ -86,9 +85,8 @@ public:
     glm::vec3 PreviousPosition;
 	glm::vec3 PreviousVelocity;
 
-    // Pickups (items)
-	std::map <std::string, float> temporaryItems = {};
-    std::vector<std::string> items = {};
+    // Pickups (items), timed boosts and permanent items alike
+    StatusEffects effects;
     void AddPickup(Pickup* pickup, float lifetime=-1.0f);
 	void RemovePickup(Pickup* pickup);
 
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "assetLoader.h"
+#include "mesh.h"
+
+class Shader;
+class TextRenderer;
+
+struct PreloadEntry {
+    enum class Type { Model, Texture, Font };
+
+    Type type;
+    std::string name;  // ResourceManager key, unused for fonts
+    std::string file;  // relative to IMAGE_DIR, or FONT_DIR for fonts
+    GeometryRetention retention = GeometryRetention::Release;
+    unsigned int fontSize = 0;
+};
+
+// Declarative list of the assets Game::Init loads before gameplay starts,
+// read from a data file so new assets don't need a code change.
+class PreloadManifest {
+public:
+    // replaces the entries with the file content, false if it can't be opened
+    static bool Load(const std::string& path);
+
+    // queues every entry that is not resident yet, returns the handles to wait on
+    static std::vector<AssetHandle> Request(Shader* shader, TextRenderer* textRenderer);
+
+    static const std::vector<PreloadEntry>& Entries() { return entries; }
+
+private:
+    PreloadManifest() { }
+    static std::vector<PreloadEntry> entries;
+};
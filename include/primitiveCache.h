@@ -0,0 +1,53 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <map>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+// GPU buffers of a generated primitive, shared by every shape using it
+struct PrimitiveGeometry {
+    GLuint VAO = 0;
+    GLuint buffers[2] = { 0, 0 };
+    unsigned int num_indices = 0;
+
+    // vertices are interleaved position/normal
+    PrimitiveGeometry(const std::vector<float>& vertices, const std::vector<unsigned int>& indices);
+    ~PrimitiveGeometry();
+
+    // owns GL objects, never copied
+    PrimitiveGeometry(const PrimitiveGeometry&) = delete;
+    PrimitiveGeometry& operator=(const PrimitiveGeometry&) = delete;
+};
+
+enum class PrimitiveType {
+    Sphere,
+    Capsule,
+    Box
+};
+
+// Builds each (type, dimensions, tessellation) primitive once. Geometry is
+// normalized (unit radius / unit cube) so shapes apply their size through
+// the model matrix and creating a shape allocates no GL objects.
+class PrimitiveCache {
+public:
+    static std::shared_ptr<const PrimitiveGeometry> GetSphere(int slices);
+    static std::shared_ptr<const PrimitiveGeometry> GetBox();
+    // capsule of radius 1, only the height/radius ratio changes the mesh
+    static std::shared_ptr<const PrimitiveGeometry> GetCapsule(float heightOverRadius, unsigned int segments, unsigned int rings);
+
+    static size_t Size() { return cache.size(); }
+    static void Clear();
+
+private:
+    PrimitiveCache() { }
+
+    // (type, dimension, tessellation u, tessellation v)
+    typedef std::tuple<PrimitiveType, float, int, int> Key;
+    static std::map<Key, std::shared_ptr<const PrimitiveGeometry>> cache;
+
+    static std::shared_ptr<const PrimitiveGeometry> buildSphere(int slices);
+    static std::shared_ptr<const PrimitiveGeometry> buildBox();
+    static std::shared_ptr<const PrimitiveGeometry> buildCapsule(float height, unsigned int segments, unsigned int rings);
+};
@@ -4,6 +4,7 @@
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <cstdint>
 #include <vector>
 
 class Enemy;
@@ -26,13 +27,20 @@ public:
 
 	void deactivate() { active = false; }
 
+	// rearms a pooled projectile: state of a fresh shot, enabled again
+	void Launch(glm::vec3 position, glm::vec3 velocity, float damage, float range);
+
 	void setPierce(int p);
 	void reducePierce(int amount);
 	int getPierce();
 
-	std::vector<Enemy*> getPiercedEnemies();
+	const std::vector<Enemy*>& getPiercedEnemies() const { return piercedEnemies; }
 	void addPiercedEnemy(Enemy* enemy);
 
+	// horde ghosts by Horde id, a ghost is only hit once per shot
+	bool hasPiercedGhost(uint32_t id) const;
+	void addPiercedGhost(uint32_t id);
+
 private:
 
 	bool active;
@@ -44,4 +52,5 @@ private:
 	float traveledDistance;
 	int pierce;
 	std::vector<Enemy*> piercedEnemies;
+	std::vector<uint32_t> piercedGhosts;
 };
\ No newline at end of file
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+class Projectile;
+
+// Fixed set of projectiles built once. Dead projectiles stay registered with
+// physics, disabled, and go back to a free list: firing allocates nothing and
+// never goes through the deletion queue.
+class ProjectilePool {
+public:
+    static void Init(size_t capacity);
+
+    // nullptr when every projectile is in flight, the shot is then skipped
+    static Projectile* Acquire();
+    static void Release(Projectile* projectile);
+
+    static size_t Capacity() { return all.size(); }
+    static size_t FreeCount() { return freeList.size(); }
+
+private:
+    ProjectilePool() { }
+
+    static std::vector<Projectile*> all;
+    static std::vector<Projectile*> freeList;
+};
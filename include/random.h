@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+
+// Small seedable PRNG (PCG32), cheaper than rand() and independent of the
+// global C state, so each system can own its own reproducible stream.
+class Random {
+public:
+    explicit Random(uint64_t seed = 0x853c49e6748fea9bULL) { Seed(seed); }
+
+    void Seed(uint64_t seed) {
+        state = 0;
+        NextU32();
+        state += seed;
+        NextU32();
+    }
+
+    uint32_t NextU32() {
+        uint64_t old = state;
+        state = old * 6364136223846793005ULL + increment;
+        uint32_t xorshifted = static_cast<uint32_t>(((old >> 18u) ^ old) >> 27u);
+        uint32_t rot = static_cast<uint32_t>(old >> 59u);
+        return (xorshifted >> rot) | (xorshifted << ((32u - rot) & 31u));
+    }
+
+    // uniform in [0, 1)
+    float NextFloat() { return (NextU32() >> 8) * (1.0f / 16777216.0f); }
+
+    // uniform in [0, bound), bound > 0 (multiply-shift, bias below 2^-32 * bound)
+    uint32_t NextBelow(uint32_t bound) {
+        return static_cast<uint32_t>((static_cast<uint64_t>(NextU32()) * bound) >> 32);
+    }
+
+private:
+    uint64_t state;
+    static const uint64_t increment = 1442695040888963407ULL;
+};
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "shader.h"
+#include "shape.h"
+
+// GL state changes issued during a frame
+struct RenderStats {
+    int programBinds = 0;
+    int vaoBinds = 0;
+    int textureBinds = 0;
+    int materialChanges = 0;
+    int drawCalls = 0;
+};
+
+// Collects the shape draws of a pass and issues them sorted by a 64-bit key
+// (pass, shader, material, VAO, depth): opaque items front-to-back, then
+// transparent items back-to-front with depth writes off. Only the program,
+// VAO and material uniforms that actually change between items are set.
+class RenderQueue {
+public:
+    enum Layer {
+        Opaque,
+        Transparent
+    };
+
+    static bool Enabled;
+
+    // empty the queue and start collecting a pass, depth is measured from eye
+    static void Begin(const glm::vec3& eye, glm::mat4& view, glm::mat4& projection);
+
+    // queue a shape, returns false if it must be drawn directly
+    static bool Submit(const Shape* shape, const glm::mat4& model);
+
+    // sort and draw the queued items of a layer
+    static void Flush(Layer layer);
+
+    // every texture bind goes through the queue, so binds are counted and
+    // redundant ones skipped; deleting through it keeps that cache valid
+    static void BindTexture(GLenum unit, GLenum target, GLuint texture);
+    static void DeleteTexture(GLuint texture);
+
+    // called once per frame, keeps the counters of the frame that ended
+    static void ResetStats();
+    static const RenderStats& GetStats() { return stats; }
+    static const RenderStats& GetLastFrameStats() { return lastFrame; } // shown in the stats menu
+
+private:
+    RenderQueue() { }
+
+    struct Item {
+        const Shape* shape;
+        Shader* shader;
+        DrawGeometry geometry;
+        glm::mat4 model;
+    };
+
+    // material uniforms last set on the current program
+    struct MaterialState {
+        glm::vec3 color;
+        float alpha;
+        bool useCheckerboard;
+        bool isEmissive;
+
+        bool operator==(const MaterialState& o) const {
+            return color == o.color && alpha == o.alpha && useCheckerboard == o.useCheckerboard && isEmissive == o.isEmissive;
+        }
+    };
+
+    static std::vector<Item> items;
+    static std::vector<std::pair<uint64_t, uint32_t>> keys[2]; // (sort key, item index) per layer
+    static glm::vec3 eye;
+    static glm::mat4 view;
+    static glm::mat4 projection;
+    static RenderStats stats;
+    static RenderStats lastFrame;
+    static GLuint boundTextures[8];
+    static GLenum activeUnit;
+
+    static uint64_t makeKey(Layer layer, const Item& item, uint16_t material, float depth);
+};
@@ -14,11 +14,15 @@ public:
     static Shader* LoadShader(std::string vShaderFile, std::string fShaderFile, std::string name);
     static Shader* GetShader(std::string name);
 
-    static Model* LoadModel(std::string file, std::string name, Shader* shader);
+    static Model* LoadModel(std::string file, std::string name, Shader* shader, GeometryRetention retention = GeometryRetention::Release);
     static Model* GetModel(std::string name);
+    static void ReleaseModel(std::string name); // deletes a model only needed during loading
+    static void LogGeometryMemory(); // resident CPU bytes per loaded model
 
     static unsigned int LoadTexture(std::string file, std::string name);
     static unsigned int GetTexture(std::string name);
+    // GL half of LoadTexture, pixels are RGBA8 already decoded
+    static unsigned int CreateTexture(const unsigned char* pixels, int width, int height);
 
     static void Clear();
 
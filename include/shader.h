@@ -4,6 +4,25 @@
 #include <glad/glad.h>
 
 #include <string>
+#include <unordered_map>
+
+/** \brief Uniforms set on every draw, resolved once after linking.*/
+enum class Uniform {
+    Model,
+    View,
+    Projection,
+    NormalMatrix,
+    ObjectColor,
+    Alpha,
+    UseCheckerboard,
+    IsEmissive,
+    ShadowMap,
+    NumActiveLights,
+    LightPos,
+    LightColors,
+    LightIntensities,
+    Count
+};
 
 /** \brief A graphic program.*/
 class Shader {
@@ -16,8 +35,17 @@ public:
 
     GLuint get_id();
 
+    /** \brief Location of a well-known uniform, -1 if the program doesn't use it.*/
+    GLint location(Uniform uniform) const { return locations[static_cast<int>(uniform)]; }
+
+    /** \brief Location of any other uniform, queried once then cached.*/
+    GLint location(const std::string& name);
+
 private:
     GLuint glid;
+    GLint locations[static_cast<int>(Uniform::Count)];
+    std::unordered_map<std::string, GLint> namedLocations;
+
     GLuint compile_shader(const std::string& path, GLenum shader_type);
 };
 
@@ -8,12 +8,31 @@
 #include "glm/ext.hpp"
 #include <glm/gtc/matrix_transform.hpp>
 
+// GPU geometry a shape draws with, used to batch identical shapes
+struct DrawGeometry {
+    GLuint VAO = 0;             // 0 when the shape can't be batched
+    GLsizei indexCount = 0;
+    GLenum indexType = GL_UNSIGNED_INT;
+    glm::vec3 scale = glm::vec3(1.0f);  // local scale applied on top of the model matrix
+    glm::vec3 offset = glm::vec3(0.0f); // local translation, applied before the scale
+
+    // model matrix to draw the geometry with
+    glm::mat4 localTransform(const glm::mat4& model) const {
+        return glm::scale(glm::translate(model, offset), scale);
+    }
+};
+
 class Shape {
 public:
     Shape(Shader *shader_program);
 
     virtual void draw(glm::mat4& model, glm::mat4& view, glm::mat4& projection);
 
+    // geometry and color used by the instanced path
+    virtual DrawGeometry getGeometry() const { return DrawGeometry(); }
+    virtual glm::vec3 getColor() const { return color; }
+    Shader* getShader() const { return shader_; }
+
     virtual ~Shape() = default;
     glm::vec3 color;
     float alpha = 1.0f;
@@ -25,5 +44,6 @@ public:
     }
 
 protected:
+    Shader* shader_;
     GLuint shader_program_;
 };
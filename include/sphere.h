@@ -1,5 +1,6 @@
 #include "shader.h"
 #include "shape.h"
+#include "primitiveCache.h"
 
 #include <glm/glm.hpp>
 #include "glm/ext.hpp"
@@ -11,14 +12,15 @@ public:
     Sphere(Shader *shader_program, float radius = 0.5f, int slices = 16);
     float radius;
     void draw(glm::mat4& model, glm::mat4& view, glm::mat4& projection);
-    virtual ~Sphere();
     virtual Shape* clone() const override {
         return new Sphere(*this);
     }
 
 
+    DrawGeometry getGeometry() const override {
+        return DrawGeometry{ geometry->VAO, static_cast<GLsizei>(geometry->num_indices), GL_UNSIGNED_INT, glm::vec3(radius) };
+    }
+
 private:
-    unsigned int num_indices;
-    GLuint VAO;
-    GLuint buffers[2];
+    std::shared_ptr<const PrimitiveGeometry> geometry; // unit sphere, scaled by radius
 };
\ No newline at end of file
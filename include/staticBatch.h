@@ -0,0 +1,61 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+
+#include "shape.h"
+#include "shader.h"
+#include "material.h"
+#include "primitiveCache.h"
+
+class Node;
+
+// Static geometry baked into world space and merged into a single vertex and
+// index buffer. Indices are grouped by material, each group keeps one
+// sub-range per source mesh so hidden ranges can be culled. A draw issues one
+// glMultiDrawElements per material.
+class StaticBatch : public Shape {
+public:
+    // sub-range of the index buffer coming from one source mesh
+    struct Range {
+        GLsizei indexCount;
+        size_t indexOffset; // in bytes
+        glm::vec3 aabbMin;  // world space
+        glm::vec3 aabbMax;
+    };
+
+    struct MaterialGroup {
+        MaterialID material;
+        std::vector<Range> ranges;
+    };
+
+    // bakes every mesh below root, the meshes must still hold their CPU arrays
+    StaticBatch(Shader* shader, Node* root);
+
+    void draw(glm::mat4& model, glm::mat4& view, glm::mat4& projection) override;
+
+    // clones share the merged buffers
+    Shape* clone() const override {
+        return new StaticBatch(*this);
+    }
+
+    size_t gpuBytes() const;
+    int getSourceMeshCount() const { return sourceMeshes; }
+    int getLastDrawCalls() const { return lastDrawCalls; }
+    int getLastVisibleRanges() const { return lastVisibleRanges; }
+
+private:
+    std::shared_ptr<const PrimitiveGeometry> geometry; // interleaved world-space position/normal
+    size_t vertexCount;
+    size_t indexCount;
+    int sourceMeshes;
+    std::vector<MaterialGroup> groups;
+
+    // scratch arrays reused by every draw
+    std::vector<GLsizei> drawCounts;
+    std::vector<const void*> drawOffsets;
+    int lastDrawCalls;
+    int lastVisibleRanges;
+};
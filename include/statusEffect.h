@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Everything the player can carry. Values index the timer array and the
+// active bitmask, keep Count under 32.
+enum class StatusEffect : uint8_t {
+    // timed, from loot drops
+    DamageBoost,
+    SpeedBoost,
+    Fear,
+    // permanent items
+    Laser,
+    Pierce,
+    Bounce,
+    Count,
+    None = Count
+};
+
+// name of an effect as written in the loot and pickup tables, "" for None
+const char* StatusEffectName(StatusEffect effect);
+// inverse of StatusEffectName, None with a logged error for unknown names
+StatusEffect StatusEffectFromName(std::string_view name);
+
+// Active effects as a bitmask with one timer per effect: a check is a bit
+// test, the per-frame update only walks the timed bits.
+class StatusEffects {
+public:
+    static const size_t EffectCount = static_cast<size_t>(StatusEffect::Count);
+
+    // negative lifetime: permanent, otherwise refreshed to the longer timer
+    void Add(StatusEffect effect, float lifetime = -1.0f);
+    void Remove(StatusEffect effect);
+    void Clear();
+
+    bool Has(StatusEffect effect) const { return (active & bit(effect)) != 0; }
+    uint32_t Mask() const { return active; }
+    float Remaining(StatusEffect effect) const; // 0 for inactive or permanent effects
+
+    // counts the timed effects down, drops the expired ones
+    void Update(float deltaTime);
+
+private:
+    static uint32_t bit(StatusEffect effect) { return 1u << static_cast<uint32_t>(effect); }
+
+    float timers[EffectCount] = {};
+    uint32_t active = 0;
+    uint32_t timed = 0; // subset of active with a running timer
+};
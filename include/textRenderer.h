@@ -1,5 +1,6 @@
 #pragma once
 #include <map>
+#include <vector>
 
 #include <glad/glad.h>
 #include <glm/glm.hpp>
@@ -16,12 +17,23 @@ struct Character {
     unsigned int Advance; // Offset to advance to next glyph
 };
 
+// glyph rasterized on the CPU, waiting for its texture upload
+struct GlyphBitmap {
+    char Code;
+    glm::ivec2 Size;
+    glm::ivec2 Bearing;
+    unsigned int Advance;
+    std::vector<unsigned char> Pixels; // one byte per texel, rows tightly packed
+};
+
 class TextRenderer
 {
 public:
     std::map<char, Character> Characters; // holds all precompiled characters
     TextRenderer(unsigned int width, unsigned int height); // constructor
     void Load(std::string font, unsigned int fontSize); // pre-compiles a list of characters from the given font
+    static bool Rasterize(std::string font, unsigned int fontSize, std::vector<GlyphBitmap>& glyphs); // FreeType only, safe off the GL thread
+    void Upload(const std::vector<GlyphBitmap>& glyphs); // creates the glyph textures
     void RenderText(std::string text, float x, float y, float scale, glm::vec3 color = glm::vec3(1.0f)); // renders a string of text using the precompiled list of characters
 private:
     unsigned int VAO, VBO;
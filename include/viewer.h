@@ -16,7 +16,11 @@
 
 class Viewer {
 public:
-    Viewer(int width=640, int height=480);
+    // headless: no window and no GL context, GL calls go to the NullRenderer
+    // and nothing is drawn, the caller steps the game itself
+    Viewer(int width=640, int height=480, bool headless=false);
+
+    const bool headless;
 
     float deltaTime = 0.0f; 
     float lastFrame = 0.0f;
@@ -36,6 +40,7 @@ public:
 
     std::function<void()> update_callback; // Fonction de rappel pour les mises à jour par frame
     std::function<void()> draw_ui_callback; // Draw UI callback
+    std::function<float()> tick_callback; // starts a frame in place of GameClock::Tick, e.g. an InputLog
 
     glm::vec3 backgroundColor = glm::vec3(0.2f, 0.2f, 0.2f);
 
@@ -46,6 +51,7 @@ private:
     float lastY;
     bool firstMouse;
     
+    bool initWindow(int width, int height);
     static void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods);
     static void mouse_callback(GLFWwindow* window, double xposIn, double yposIn);
     static void mouse_button_callback(GLFWwindow* window, int button, int action, int mods);
@@ -6,29 +6,33 @@
 in vec3 fragPos; // fragment position in world space
 in vec3 normal; // normal vector
 in vec4 fragPosLightSpace; // fragment position in light space
+in vec3 vertexColor; // base color of the object (uniform or per instance)
+in float vertexAlpha; // alpha value for transparency (uniform or per instance)
 
 out vec4 out_color; // final fragment color
 
 // Uniforms
-uniform vec3 objectColor; // base color of the object
-uniform vec3 viewPos; // camera position
+// per-frame data shared by every lit program, see FrameUniforms
+layout (std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    mat4 lightSpaceMatrix;
+    vec4 viewPos;      // xyz = camera position
+    vec4 fogColor;     // color of the fog
+    vec4 fogRange;     // x = distance where fog starts, y = distance where it ends
+    vec4 sunPos;       // xyz = directional light position
+    int isShadowPass;  // 1 while rendering the shadow map
+};
+
 uniform bool useCheckerboard; // If true, apply checkerboard pattern
 uniform bool isEmissive; // if true, object is emissive (it becomes a light source)
 
-uniform vec4 fogColor; // color of the fog
-uniform float fogStart; // distance where fog starts
-uniform float fogEnd; // distance where fog ends
-
 uniform int numActiveLights; // number of active point lights
 uniform vec3 lightPos[MAX_LIGHTS]; // positions of point lights
 uniform vec3 lightColors[MAX_LIGHTS]; // colors of point lights
 uniform float lightIntensities[MAX_LIGHTS]; // intensities of point lights
 
-uniform float alpha = 1.0; // alpha value for transparency
-
 uniform sampler2D shadowMap; // shadow map texture
-uniform vec3 dirLightPos; // directional light position (sun)
-uniform bool isShadowPass; // if true, we are rendering the shadow pass
 
 // Function to calculate shadow factor
 float shadowCalculation(vec4 fragPosLightSpace, vec3 normal, vec3 lightDir)
@@ -64,12 +68,12 @@ vec4 applyFog(vec4 baseColor, float vis) {
 vec3 getCheckerboardColor(vec3 position) {
     float f = floor(position.x) + floor(position.z);
     bool isEven = mod(f, 2.0) == 0.0;
-    return isEven ? objectColor : objectColor * 0.5;
+    return isEven ? vertexColor : vertexColor * 0.5;
 }
 
 void main() {
     // Skip lighting calculations during shadow pass
-    if (isShadowPass) {
+    if (isShadowPass != 0) {
         return;
     }
 
@@ -78,11 +82,13 @@ void main() {
     float horizontalDist = length(viewPosXZ - fragPosXZ); // horizontal distance from camera to fragment
     
     // fog visibility calculation
+    float fogStart = fogRange.x;
+    float fogEnd = fogRange.y;
     float visibility = clamp((fogEnd - horizontalDist) / (fogEnd - fogStart), 0.0, 1.0);
 
     // Emissive objects are not affected by lighting
     if (isEmissive) {
-        out_color = applyFog(vec4(objectColor, 1.0), visibility);
+        out_color = applyFog(vec4(vertexColor, 1.0), visibility);
         return;
     }
 
@@ -91,17 +97,17 @@ void main() {
     if (useCheckerboard) {
         baseColor = getCheckerboardColor(fragPos);
     } else {
-        baseColor = objectColor;
+        baseColor = vertexColor;
     }
 
     // Lighting calculations (Phong model)
     vec3 norm = normalize(normal);
-    vec3 viewDir = normalize(viewPos - fragPos);
+    vec3 viewDir = normalize(viewPos.xyz - fragPos);
     // ambient light
     vec3 ambient = 0.3 * baseColor;
 
     // Directional light (sun)
-    vec3 lightDir = normalize(dirLightPos - fragPos);
+    vec3 lightDir = normalize(sunPos.xyz - fragPos);
     // diffuse light (Lambertian reflection)
     float diff = max(dot(norm, lightDir), 0.0);
 
@@ -133,5 +139,5 @@ void main() {
     vec3 finalColorRGB = ambient + (baseColor * sunLighting) + (baseColor * pointLightContribution);
     
     // apply fog to the final color
-    out_color = applyFog(vec4(finalColorRGB, alpha), visibility);
+    out_color = applyFog(vec4(finalColorRGB, vertexAlpha), visibility);
 }
\ No newline at end of file
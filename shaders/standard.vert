@@ -4,15 +4,28 @@ layout (location = 0) in vec3 position;
 layout (location = 1) in vec3 anormal;
 
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
-
 uniform mat3 normalMatrix;
-uniform mat4 lightSpaceMatrix;
+
+// per-frame data shared by every lit program, see FrameUniforms
+layout (std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    mat4 lightSpaceMatrix;
+    vec4 viewPos;      // xyz = camera position
+    vec4 fogColor;     // color of the fog
+    vec4 fogRange;     // x = distance where fog starts, y = distance where it ends
+    vec4 sunPos;       // xyz = directional light position
+    int isShadowPass;  // 1 while rendering the shadow map
+};
+
+uniform vec3 objectColor; // base color of the object
+uniform float alpha = 1.0; // alpha value for transparency
 
 out vec3 fragPos;
 out vec3 normal;
 out vec4 fragPosLightSpace;
+out vec3 vertexColor;
+out float vertexAlpha;
 
 void main() {
     vec4 cameraSpacePos = view * model * vec4(position, 1.0);
@@ -21,5 +34,8 @@ void main() {
 
     normal = normalize(normalMatrix * anormal);
 
-    fragPosLightSpace = lightSpaceMatrix * vec4(position, 1.0);
+    fragPosLightSpace = lightSpaceMatrix * vec4(fragPos, 1.0);
+
+    vertexColor = objectColor;
+    vertexAlpha = alpha;
 }
\ No newline at end of file
@@ -0,0 +1,40 @@
+#version 330 core
+
+layout (location = 0) in vec3 position;
+layout (location = 1) in vec3 anormal;
+
+// per-instance attributes (divisor 1)
+layout (location = 4) in mat4 instanceModel; // uses locations 4 to 7
+layout (location = 8) in vec4 instanceColor; // rgb = color, a = alpha
+
+// per-frame data shared by every lit program, see FrameUniforms
+layout (std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    mat4 lightSpaceMatrix;
+    vec4 viewPos;      // xyz = camera position
+    vec4 fogColor;     // color of the fog
+    vec4 fogRange;     // x = distance where fog starts, y = distance where it ends
+    vec4 sunPos;       // xyz = directional light position
+    int isShadowPass;  // 1 while rendering the shadow map
+};
+
+out vec3 fragPos;
+out vec3 normal;
+out vec4 fragPosLightSpace;
+out vec3 vertexColor;
+out float vertexAlpha;
+
+void main() {
+    vec4 cameraSpacePos = view * instanceModel * vec4(position, 1.0);
+    gl_Position = projection * cameraSpacePos;
+    fragPos = vec3(instanceModel * vec4(position, 1.0));
+
+    mat3 normalMatrix = transpose(inverse(mat3(instanceModel)));
+    normal = normalize(normalMatrix * anormal);
+
+    fragPosLightSpace = lightSpaceMatrix * vec4(fragPos, 1.0);
+
+    vertexColor = instanceColor.rgb;
+    vertexAlpha = instanceColor.a;
+}
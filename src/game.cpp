@@ -6,30 +6,54 @@
 #include "sprite.h"
 
 #include "model.h"
+#include "material.h"
 #include "entityLoader.h"
 #include "constants.h"
 #include "projectile.h"
-
-Game::Game(Viewer* v) : viewer(v) {
+#include "instancedRenderer.h"
+#include "primitiveCache.h"
+#include "frameUniforms.h"
+#include "assetLoader.h"
+#include "preloadManifest.h"
+#include "hitchDetector.h"
+#include "enemyPool.h"
+#include "projectilePool.h"
+#include "lootTable.h"
+#include "flowField.h"
+#include "crowd.h"
+#include "horde.h"
+#include "aiLod.h"
+#include "gameClock.h"
+
+Game::Game(Viewer* v, GameMode mode, uint64_t seed) : viewer(v), mode(mode), lootRandom(seed) {
+    enemiesToWin = mode == GameMode::Horde ? Config::Horde::ENEMIES_TO_WIN : Config::Game::EnemiesToWin;
     handlePhysics = new HandlePhysics(v->scene_root);
 }
 
 Game::~Game() {
+    AssetLoader::Shutdown();
+    Horde::Shutdown();
     delete handlePhysics;
     delete crosshair;
 }
 
 void Game::Init() {
     std::string shaderDir = SHADER_DIR;
-    std::string imageDir = IMAGE_DIR;
-    std::string fontDir = FONT_DIR;
+    std::string dataDir = DATA_DIR;
+
+    // materials must be known before any model is imported
+    if (MaterialTable::Size() <= 1) {
+        MaterialTable::Load(dataDir + "materials.txt");
+    }
 
     if (ResourceManager::GetShader("standard") == nullptr) {
         ResourceManager::LoadShader(shaderDir + "standard.vert", shaderDir + "standard.frag", "standard");
     }
-        if (ResourceManager::GetTexture("crosshair") == 0) {
-        ResourceManager::LoadTexture(imageDir + "crosshair.png", "crosshair");
+    if (ResourceManager::GetShader("standardInstanced") == nullptr) {
+        ResourceManager::LoadShader(shaderDir + "standard_instanced.vert", shaderDir + "standard.frag", "standardInstanced");
+        InstancedRenderer::Init(ResourceManager::GetShader("standardInstanced"));
     }
+    FrameUniforms::Init();
     if (ResourceManager::GetShader("sprite") == nullptr) {
         ResourceManager::LoadShader(shaderDir + "sprite.vert", shaderDir + "sprite.frag", "sprite");
     }
@@ -37,52 +61,112 @@ void Game::Init() {
         ResourceManager::LoadShader(shaderDir + "text.vert", shaderDir + "text.frag", "text");
     }
 
-    viewer->scene_root->recursiveReset();
+    Shader* StandardShader = ResourceManager::GetShader("standard");
+
+    spriteRenderer = new Sprite(ResourceManager::GetShader("sprite"));
+
+    // Set sky color
+    skyColor = glm::vec3(0.2f, 0.2f, 0.2f);
+    viewer->backgroundColor = skyColor;
 
-    // load font
+    // everything gameplay needs is listed in the preload manifest and decoded
+    // in parallel on the loader threads, the window shows a progress bar
+    // while the uploads come in
+    HitchDetector::SetHotPath(false);
+    PreloadManifest::Load(dataDir + "preload.txt");
     textRenderer = new TextRenderer(Config::SCR_WIDTH, Config::SCR_HEIGHT);
-    textRenderer->Load(fontDir + "JetBrains-Mono-Nerd-Font-Complete.ttf", 24);
+    std::vector<AssetHandle> required = PreloadManifest::Request(StandardShader, textRenderer);
 
-    Shader* StandardShader = ResourceManager::GetShader("standard");
+    // without a window there is nothing to present, block on the loads
+    // instead of spinning against the loader threads
+    if (viewer->headless) {
+        for (AssetHandle handle : required) AssetLoader::Wait(handle);
+    }
 
-    spriteRenderer = new Sprite(ResourceManager::GetShader("sprite"));
+    size_t loaded = 0;
+    while (loaded < required.size()) {
+        AssetLoader::ProcessUploads(Config::Loading::LOADING_SCREEN_BUDGET_MS);
+        loaded = 0;
+        for (AssetHandle handle : required) {
+            if (AssetLoader::GetState(handle) != AssetState::Loading) loaded++;
+        }
+        RenderLoadingUI(static_cast<float>(loaded) / static_cast<float>(required.size()));
+    }
 
+    //Load map, it lives for the whole session
+    map = new Map(StandardShader, viewer->scene_root);
+    
+    //Load player
+    player = EntityLoader::CreatePlayer(Config::Player::SPAWN_POS);
+    viewer->scene_root->add(player);
+
+    // load stats menu
+    statsMenu = new StatsMenu(textRenderer, player);
+
+    // enemies are recycled, a few of each tier are built before the first spawn
+    EnemyPool::Init(viewer->scene_root);
+    if (mode == GameMode::Horde) {
+        Horde::Init(viewer->scene_root, lootRandom.NextU32());
+    } else {
+        for (int tier = 1; tier <= EnemyPool::TierCount; tier++) {
+            EnemyPool::Prewarm(tier, Config::EnemySpawner::PREWARM_PER_TIER);
+        }
+    }
+
+    // Mobs Spawners, the horde spawns its own ghosts
+    if (mode != GameMode::Horde) {
+        EnemySpawner* spawner1 = EntityLoader::CreateEnemySpawner(viewer->scene_root, player->Position, enemies, lootRandom.NextU32());
+        viewer->scene_root->add(spawner1);
+        enemySpawner = spawner1;
+    }
+
+    // crosshair setup
+    crosshair = new Crosshair(0.1f);
+    crosshairTexture = ResourceManager::GetTexture("crosshair");
+
+    // Textures come from the preload manifest
+    gameOverTexture = ResourceManager::GetTexture("gameOver");
+    healthBarTexture = ResourceManager::GetTexture("healthBar");
+    experienceBarTexture = ResourceManager::GetTexture("experienceBar");
+    victoryTexture = ResourceManager::GetTexture("victory");
+
+    Shape* camShape = new Sphere(StandardShader, 0.5f);
+    viewer->camera->collisionShape = camShape;
+    viewer->camera->collisionGroup = CG_PLAYER;
+    viewer->camera->collisionMask = CG_ENVIRONMENT;
+    viewer->camera->SetMass(1.0f);
+
+    // every projectile is built now, firing never allocates or creates GL objects
+    ProjectilePool::Init(Config::Projectile::POOL_CAPACITY);
+
+    ResourceManager::LogGeometryMemory();
+
+    StartRun();
+
+    // from here on any load is a gameplay hitch, including during resets
+    HitchDetector::SetHotPath(true);
+}
+
+void Game::StartRun() {
     // Set fog uniforms
     fogColor = Config::Game::fogColor;
     fogStart = Config::Game::fogStartDistance;
     fogEnd = Config::Game::fogEndDistance;
-    // Set sky color
-    skyColor = glm::vec3(0.2f, 0.2f, 0.2f);
     viewer->backgroundColor = skyColor;
 
     enemyKilled = 0;
     hasWon = false;
     isTimeRecorded = false;
     timeRecorded = 0.0;
+    resetGameTime = GameClock::Now();
 
-    glUseProgram(StandardShader->get_id());
-    this->fogColorLocation = glGetUniformLocation(StandardShader->get_id(), "fogColor");
-    this->fogStartLocation = glGetUniformLocation(StandardShader->get_id(), "fogStart");
-    this->fogEndLocation = glGetUniformLocation(StandardShader->get_id(), "fogEnd");
-
-    //Load map
-    Map* map = new Map(StandardShader, viewer->scene_root);
-    
-    if(!player){
-            //Load player
-            player = EntityLoader::CreatePlayer(glm::vec3(0.0f, 10.0f, 0.0f));
-            viewer->scene_root->add(player);
-    }
-
-    // load stats menu
-    statsMenu = new StatsMenu(textRenderer, player);
-
-    // Mobs Spawners
-    EnemySpawner* spawner1 = EntityLoader::CreateEnemySpawner(viewer->scene_root, player->Position, enemies);
-    viewer->scene_root->add(spawner1);
-	enemySpawner = spawner1;
     // reset spawn probabilities
     EnemySpawner::updateSpawnProbabilities(1);
+    if (enemySpawner) {
+        enemySpawner->Position = player->Position;
+        enemySpawner->Reset();
+    }
+    statsMenu->setVisible(false);
 
     // Add a boulder prop
     PhysicShapeObject* boulder = EntityLoader::Boulder(glm::vec3(10.0f, 5.0f, 10.0f), 2.0f, 200.0f);
@@ -90,24 +174,126 @@ void Game::Init() {
 
     PhysicShapeObject* boulder2 = EntityLoader::Boulder(glm::vec3(8.0f, 5.0f, 12.0f), 0.5f, 15.0f);
     viewer->scene_root->add(boulder2);
+}
 
+void Game::ResetRun() {
+    // only dynamic entities go, the map, its colliders, the player model,
+    // the HUD and every loaded asset stay
+    for(auto enemy : enemies){
+        EnemyPool::Release(enemy);
+    }
+    enemies.clear();
+    Horde::Clear();
+
+    // delete boulders
+    auto& allObjects = PhysicObject::allPhysicObjects;
+    for (auto it = allObjects.begin(); it != allObjects.end(); ) {
+        PhysicObject* obj = *it;
+        // Check if the object is named "Boulder" (case sensitive)
+        if (obj->name.find("Boulder") != std::string::npos) {
+            if (PhysicShapeObject* pso = dynamic_cast<PhysicShapeObject*>(obj)) {
+                viewer->scene_root->recursiveRemove(pso);
+            }
+            delete obj;
+            // Reset iterator because 'allObjects' is modified by delete
+            it = allObjects.begin(); 
+        } else {
+            ++it;
+        }
+    }
 
-    // crosshair setup
-    crosshair = new Crosshair(0.1f);
-    crosshairTexture = ResourceManager::GetTexture("crosshair");
+    // pickups left on the ground
+    viewer->scene_root->recursiveReset();
 
-    // Load Textures
-    gameOverTexture = ResourceManager::LoadTexture(imageDir + "game_over.png", "gameOver");
-    healthBarTexture = ResourceManager::LoadTexture(imageDir + "white_dot.png", "healthBar");
-    experienceBarTexture = ResourceManager::LoadTexture(imageDir + "white_dot.png", "experienceBar");
-    victoryTexture = ResourceManager::LoadTexture(imageDir + "victory_screen.png", "victory");
+    player->resetPlayerState(Config::Player::SPAWN_POS);
 
-    Shape* camShape = new Sphere(StandardShader, 0.5f);
-    viewer->camera->collisionShape = camShape;
-    viewer->camera->collisionGroup = CG_PLAYER;
-    viewer->camera->collisionMask = CG_ENVIRONMENT;
-    viewer->camera->SetMass(1.0f);
+    StartRun();
+}
+
+void Game::RenderLoadingUI(float progress) {
+    if (viewer->headless) return;
+
+    float aspectRatio = static_cast<float>(Config::SCR_WIDTH) / static_cast<float>(Config::SCR_HEIGHT);
+    GLFWwindow* window = glfwGetCurrentContext();
+    glfwPollEvents();
+
+    glClearColor(skyColor.x, skyColor.y, skyColor.z, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    glDisable(GL_DEPTH_TEST);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    // the bar texture is itself in the manifest, draw once it is there
+    unsigned int barTexture = ResourceManager::GetTexture("healthBar");
+    if (barTexture != 0) {
+        Shader* spriteShader = ResourceManager::GetShader("sprite");
+        glUseProgram(spriteShader->get_id());
+
+        glm::mat4 projection = Sprite::getProjection(aspectRatio);
+        glUniformMatrix4fv(spriteShader->location(Uniform::Projection), 1, GL_FALSE, &projection[0][0]);
+        glUniform1i(spriteShader->location("image"), 0);
 
+        float barWidth = 1.2f;
+        float barHeight = 0.04f;
+        float currentWidth = barWidth * glm::clamp(progress, 0.0f, 1.0f);
+
+        // background, then the progress on top
+        spriteRenderer->draw(barTexture, glm::vec2(0.0f, 0.0f), glm::vec2(barWidth, barHeight), 0.0f, glm::vec3(0.1f, 0.1f, 0.1f));
+        spriteRenderer->draw(barTexture, glm::vec2(-barWidth / 2.0f + currentWidth / 2.0f, 0.0f), glm::vec2(currentWidth, barHeight), 0.0f, glm::vec3(0.78f, 0.87f, 0.89f));
+    }
+
+    if (!textRenderer->Characters.empty()) {
+        std::string loadingText = "Loading " + std::to_string(static_cast<int>(progress * 100.0f)) + "%";
+        textRenderer->RenderText(loadingText, (Config::SCR_WIDTH / 2) - 80.0f, (Config::SCR_HEIGHT / 2) - 60.0f, 1.0f, glm::vec3(1.0f));
+    }
+
+    glDisable(GL_BLEND);
+    glEnable(GL_DEPTH_TEST);
+    glfwSwapBuffers(window);
+}
+
+size_t Game::getEnemyCount() const {
+    return enemies.size() + Horde::Count();
+}
+
+void Game::onEnemyKilled(glm::vec3 position, float rarity, float experience, bool rollLoot) {
+    enemyKilled++;
+    player->addExperience(experience);
+    glm::vec3 startColor = glm::vec3(0.2f, 0.2f, 0.2f); // gray
+    glm::vec3 endColor   = glm::vec3(0.53f, 0.81f, 0.92f); // blue
+
+    float ratio = (float)enemyKilled / (float)enemiesToWin;
+    ratio = glm::clamp(ratio, 0.0f, 1.0f);
+    glm::vec3 newColor = glm::mix(startColor, endColor, ratio);
+    
+    if(enemyKilled >= enemiesToWin && !getHasWon()) {
+        setHasWon(true);
+    }
+
+    this->fogColor = glm::vec4(newColor, 1.0f);
+    viewer->backgroundColor = newColor;
+
+    // the fog clears over a full run whatever the kill target
+    float fogStep = (float)Config::Game::EnemiesToWin / (float)enemiesToWin;
+    fogStart += 0.5f * fogStep;
+    fogEnd += 1.0f * fogStep;
+
+    if (!rollLoot) return;
+
+    // O(1) draw from the alias table of the enemy's rarity
+    LootItem loot = LootTable::Sample(rarity, lootRandom);
+    if (loot != LootItem::None) {
+        const LootInfo& info = LootTable::Info(loot);
+        Sphere* pshape = new Sphere(ResourceManager::GetShader("standard"), 0.3f);
+        pshape->color = info.color;
+
+        Pickup* drop = new Pickup(pshape, position);
+        drop->name = info.name;
+        drop->collisionShape = pshape;
+        drop->lifetime = info.lifetime;
+        drop->effect = info.effect;
+        viewer->scene_root->add(drop);
+    }
 }
 
 void Game::ProcessInput(float deltaTime) {
@@ -149,7 +335,7 @@ void Game::ProcessInput(float deltaTime) {
         player->shoot(finalShootDir);
     }
     // enable fullscreen toggle
-    if (viewer->keymap[GLFW_KEY_F]) {
+    if (viewer->keymap[GLFW_KEY_F] && !viewer->headless) {
         static bool isFullscreen = false;
         static int windowedWidth = Config::SCR_WIDTH;
         static int windowedHeight = Config::SCR_HEIGHT;
@@ -184,128 +370,77 @@ void Game::ProcessInput(float deltaTime) {
 }
 
 void Game::ProcessGameOverInput() {
-    GLFWwindow* window = glfwGetCurrentContext();
-    if (viewer->keymap[GLFW_KEY_ESCAPE]) {
+    GLFWwindow* window = viewer->headless ? nullptr : glfwGetCurrentContext();
+    if (viewer->keymap[GLFW_KEY_ESCAPE] && window) {
         glfwSetWindowShouldClose(window, GLFW_TRUE);
     }
     if(viewer->keymap[GLFW_KEY_R]) {
         viewer->keymap[GLFW_KEY_R] = false;
-        // delete enemies
-        for(auto enemy : enemies){
-            viewer->scene_root->remove(enemy);
-            delete enemy;
-        }
-        enemies.clear();
-
-        // delete boulders
-        auto& allObjects = PhysicObject::allPhysicObjects;
-        for (auto it = allObjects.begin(); it != allObjects.end(); ) {
-            PhysicObject* obj = *it;
-            // Check if the object is named "Boulder" (case sensitive)
-            if (obj->name.find("Boulder") != std::string::npos) {
-                if (PhysicShapeObject* pso = dynamic_cast<PhysicShapeObject*>(obj)) {
-                    viewer->scene_root->recursiveRemove(pso);
-                }
-                delete obj;
-                // Reset iterator because 'allObjects' is modified by delete
-                it = allObjects.begin(); 
-            } else {
-                ++it;
-            }
-        }
-
-        // reset spawners
-        viewer->scene_root->remove(enemySpawner);
-        delete enemySpawner;
-
-        resetGameTime = glfwGetTime();
-
-        player->resetPlayerState(glm::vec3(0.0f, 10.0f, 0.0f));
-
-        this->Init();
+        ResetRun();
     }
 }
 
 void Game::Update() {
+    // finish streamed loads, bounded so a big model can't stall the frame
+    AssetLoader::ProcessUploads(Config::Loading::UPLOAD_BUDGET_MS);
+
     if (!player->isAlive() || hasWon) {
         return;
     }
-    float deltaTime = viewer->deltaTime;
+    float deltaTime = GameClock::DeltaTime();
 
     // Process inputs
     ProcessInput(deltaTime);
     player->update(deltaTime);
 
-	enemySpawner->Position = player->Position;
-	enemySpawner->Update(deltaTime);
-    bool isAffraid = (player->temporaryItems.find("Fear") != player->temporaryItems.end());
+    bool isAffraid = player->effects.Has(StatusEffect::Fear);
+    FlowField::Update(player->Position);
+    // nothing past the fog is visible, the AI there runs in slices
+    AiLod::BeginFrame(fogEnd);
+
+    if (mode == GameMode::Horde) {
+        // no Enemy objects and no physics bodies: the horde spawns, moves,
+        // takes hits and drops its dead in a few passes over its arrays
+        Horde::SpawnAround(deltaTime, player->Position);
+        float damage = Horde::Update(deltaTime, player->Position, isAffraid);
+        if (damage > 0.0f) player->takeDamage(damage);
+
+        Horde::ApplyHits(player->getActiveProjectiles());
+        for (const HordeDeath& death : Horde::Deaths()) {
+            onEnemyKilled(death.position, death.rarity, death.experience,
+                          lootRandom.NextFloat() < Config::Horde::LOOT_CHANCE);
+        }
+    } else {
+        enemySpawner->Position = player->Position;
+        enemySpawner->Update(deltaTime);
+    }
+
+    // enemies keep apart by steering on a grid of this frame's positions,
+    // they have no capsule contacts between them
+    crowdPositions.clear();
+    for (Enemy* enemy : enemies) crowdPositions.push_back(enemy->Position);
+    Crowd::Build(crowdPositions.data(), crowdPositions.size());
+
+    size_t crowdIndex = 0;
     auto it = enemies.begin();
     while (it != enemies.end()) {
         Enemy* enemy = *it;
+        size_t index = crowdIndex++;
         if (!enemy->isAlive()) {
-            enemyKilled++;
-            player->addExperience(enemy->getExperienceReward());
-            glm::vec3 startColor = glm::vec3(0.2f, 0.2f, 0.2f); // gray
-            glm::vec3 endColor   = glm::vec3(0.53f, 0.81f, 0.92f); // blue
-
-            float ratio = (float)enemyKilled / (float)Config::Game::EnemiesToWin;
-            ratio = glm::clamp(ratio, 0.0f, 1.0f);
-            glm::vec3 newColor = glm::mix(startColor, endColor, ratio);
-            
-            if(enemyKilled >= Config::Game::EnemiesToWin && !getHasWon()) {
-                setHasWon(true);
-            }
-
-            this->fogColor = glm::vec4(newColor, 1.0f);
-            viewer->backgroundColor = newColor;
-
-            fogStart += 0.5f;
-            fogEnd += 1.0f;
-
-			float dropChance = static_cast<float>(rand()) / static_cast<float>(RAND_MAX) * 100.0f;
-			std::map<std::string, double> lootProbabilities = getLootTableProbabilities(enemy->getRarityCoefficient());
-			float cumulativeProbability = 0.0f;
-			for (const auto& item : lootProbabilities) {
-				if ( dropChance <= item.second + cumulativeProbability) {
-					if (item.first == "") {
-                        break; // No item dropped
-                    }
-                    Sphere* pshape = new Sphere(ResourceManager::GetShader("standard"), 0.3f);
-                    float lifetime = 0.0f;
-					if (item.first == "DamageBoost") {
-                        pshape->color = glm::vec3(1.0f, 0.0f, 0.0f);
-						lifetime = 10.0f;
-                    } else if (item.first == "SpeedBoost") {
-                        pshape->color = glm::vec3(1.0f, 1.0f, 0.0f);
-						lifetime = 10.0f;
-                    } else if (item.first == "HealthPack") {
-                        pshape->color = glm::vec3(0.0f, 1.0f, 0.0f);
-					} else if (item.first == "Fear") {
-                        pshape->color = glm::vec3(0.33f, 0.1f, 0.47f);
-						lifetime = 5.0f;
-                    }
-
-					// std::cout << "Dropping item: " << item.first << " | Probability : " << dropChance << std::endl;
-
-                    Pickup* drop = new Pickup(pshape, enemy->Position);
-                    drop->name = item.first;
-                    drop->collisionShape = pshape;
-                    drop->lifetime = lifetime;
-                    viewer->scene_root->add(drop);
-					break;
-                }
-                cumulativeProbability += item.second;
-            }
-
-
-            viewer->scene_root->remove(enemy);
-            delete enemy;
+            onEnemyKilled(enemy->Position, enemy->getRarityCoefficient(), enemy->getExperienceReward());
+            EnemyPool::Release(enemy);
             it = enemies.erase(it);
         } else {
-            enemy->moveTowardsPlayer(player->Position, deltaTime, isAffraid);
+            // near enemies re-plan every tick, the others follow their last heading
+            float distance = glm::length(player->Position - enemy->Position);
+            if (AiLod::ShouldThink(index, distance, enemy->hasHeading())) {
+                enemy->think(player->Position, isAffraid, Crowd::Steering(index));
+            }
+            enemy->advance(deltaTime);
             it++;
         }
     }
+    AiLod::EndFrame();
 
     glm::vec3 camOffset(0.0f, 2.5f, 0.0f);
     viewer->camera->SetTarget(player->Position + camOffset);
@@ -328,14 +463,6 @@ void Game::Update() {
 
     handlePhysics->Update(deltaTime);
 
-    Shader* standardShader = ResourceManager::GetShader("standard");
-    glUseProgram(standardShader->get_id());
-    
-    // send fog parameters to shader
-    glUniform4fv(fogColorLocation, 1, &fogColor[0]);
-    glUniform1f(fogStartLocation, fogStart);
-    glUniform1f(fogEndLocation, fogEnd);
-
     int activeCount = 0;
     int MAX_LIGHTS = 100;
 
@@ -368,19 +495,29 @@ void Game::Update() {
         }
     }
 
-    glUniform1i(glGetUniformLocation(standardShader->get_id(), "numActiveLights"), activeCount);
-    
-    if (activeCount > 0) {
-        glUniform3fv(glGetUniformLocation(standardShader->get_id(), "lightPos"), activeCount, lightPos.data());
-        glUniform3fv(glGetUniformLocation(standardShader->get_id(), "lightColors"), activeCount, lightColors.data());
-        glUniform1fv(glGetUniformLocation(standardShader->get_id(), "lightIntensities"), activeCount, lightIntensities.data());
+    // fog goes through the per-frame uniform buffer
+    FrameUniforms::SetFog(fogColor, fogStart, fogEnd);
+
+    // send point lights to every lit program
+    for (const char* shaderName : { "standard", "standardInstanced" }) {
+        Shader* litShader = ResourceManager::GetShader(shaderName);
+        if (!litShader) continue;
+        glUseProgram(litShader->get_id());
+
+        glUniform1i(litShader->location(Uniform::NumActiveLights), activeCount);
+        
+        if (activeCount > 0) {
+            glUniform3fv(litShader->location(Uniform::LightPos), activeCount, lightPos.data());
+            glUniform3fv(litShader->location(Uniform::LightColors), activeCount, lightColors.data());
+            glUniform1fv(litShader->location(Uniform::LightIntensities), activeCount, lightIntensities.data());
+        }
     }
 }
 
 void Game::RenderDeathUI() {
     if(!isTimeRecorded) {
         isTimeRecorded = true;
-        timeRecorded = glfwGetTime() - resetGameTime;
+        timeRecorded = GameClock::Now() - resetGameTime;
     }
     float aspectRatio = static_cast<float>(Config::SCR_WIDTH) / static_cast<float>(Config::SCR_HEIGHT);
     
@@ -412,7 +549,7 @@ void Game::RenderDeathUI() {
 void Game::RenderWinUI() {
     if(!isTimeRecorded) {
         isTimeRecorded = true;
-        timeRecorded = glfwGetTime() - resetGameTime;
+        timeRecorded = GameClock::Now() - resetGameTime;
     }
     float aspectRatio = static_cast<float>(Config::SCR_WIDTH) / static_cast<float>(Config::SCR_HEIGHT);
     
@@ -461,14 +598,14 @@ void Game::RenderUI() {
     textRenderer->RenderText(killText, Config::SCR_WIDTH - 500.0f, Config::SCR_HEIGHT - 80.0f, 1.0f, glm::vec3(1.0f));
 
     // render purification progress right top corner
-    float purificationPct = static_cast<float>(enemyKilled) / static_cast<float>(Config::Game::EnemiesToWin);
+    float purificationPct = static_cast<float>(enemyKilled) / static_cast<float>(enemiesToWin);
     purificationPct = glm::clamp(purificationPct, 0.0f, 1.0f);
     int pctDisplay = static_cast<int>(purificationPct * 100.0f);
     std::string pctText = "Purification of the world : " + std::to_string(pctDisplay) + "%";
     textRenderer->RenderText(pctText, Config::SCR_WIDTH - 500.0f, Config::SCR_HEIGHT - 50.0f , 1.0f, glm::vec3(1.0f));
 
     // render in-game timer center top
-    int totalSeconds = static_cast<int>(glfwGetTime() - resetGameTime);
+    int totalSeconds = static_cast<int>(GameClock::Now() - resetGameTime);
     int minutes = totalSeconds / 60;
     int seconds = totalSeconds % 60;
     char timeBuffer[6];
@@ -530,20 +667,4 @@ void Game::RenderUI() {
     // Restore state
     glDisable(GL_BLEND);
     glEnable(GL_DEPTH_TEST);
-}
-
-std::map<std::string, double> Game::getLootTableProbabilities(float alpha) {
-    std::map<std::string, double> adjustedProbabilities;
-    
-	double total = 0.0f;
-    for (const auto& item : lootTable) {
-        double adjustedProb = glm::exp(-1*alpha*item.second);
-        adjustedProbabilities[item.first] = adjustedProb;
-        total += adjustedProb;
-	}
-
-    for (auto& item : adjustedProbabilities) {
-        item.second *= 100.0f / total;
-    }
-	return adjustedProbabilities;
 }
\ No newline at end of file
@@ -1,20 +1,82 @@
 #include "viewer.h"
 #include "game.h"
 #include "constants.h"
+#include "benchmark.h"
+#include "headless.h"
+#include "inputLog.h"
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <ctime>
 
 #ifndef SHADER_DIR
 #error "SHADER_DIR not defined"
 #endif
 
 
-int main()
+int main(int argc, char* argv[])
 {
+    // offline benchmarks, no window
+    if (argc > 1 && std::strcmp(argv[1], "--bench-crowd") == 0) {
+        return Benchmark::Crowd();
+    }
+    if (argc > 1 && std::strcmp(argv[1], "--bench-horde") == 0) {
+        return Benchmark::Horde();
+    }
+    if (argc > 1 && std::strcmp(argv[1], "--test-loot") == 0) {
+        return Benchmark::Loot();
+    }
+    // replays a recording (see --record) without a window and prints its cost
+    if (argc > 2 && std::strcmp(argv[1], "--bench-replay") == 0) {
+        return Headless::Replay(argv[2]);
+    }
+
+    // "--horde": thousands of ghosts instead of the classic waves
+    // "--headless <frames>": no window, a virtual clock and scripted input,
+    // with "--step <seconds>" per frame and "--script <file>"
+    // "--record <file>" / "--replay <file>": every frame's input and delta time
+    // "--seed <n>": the session's random streams, from the time by default
+    GameMode mode = GameMode::Classic;
+    unsigned long headlessFrames = 0;
+    float step = Config::Headless::STEP;
+    std::string script = std::string(DATA_DIR) + "soak.txt";
+    std::string recordPath;
+    std::string replayPath;
+    uint64_t seed = static_cast<uint64_t>(std::time(nullptr));
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--horde") == 0) mode = GameMode::Horde;
+        else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) recordPath = argv[++i];
+        else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) replayPath = argv[++i];
+        else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--headless") == 0 && i + 1 < argc) headlessFrames = std::strtoul(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--step") == 0 && i + 1 < argc) step = std::strtof(argv[++i], nullptr);
+        else if (std::strcmp(argv[i], "--script") == 0 && i + 1 < argc) script = argv[++i];
+    }
+
+    if (headlessFrames > 0) {
+        return Headless::Run(mode, headlessFrames, step, script, seed);
+    }
+
+    // a replay restores the recorded mode and seed
+    InputLog log;
+    if (!replayPath.empty()) {
+        if (!log.Load(replayPath)) return 1;
+        mode = log.Mode();
+        seed = log.Seed();
+    } else if (!recordPath.empty() && !log.Record(recordPath, seed, mode)) {
+        return 1;
+    }
+
     // Create viewer instance
     Viewer viewer(Config::SCR_WIDTH, Config::SCR_HEIGHT);
-    Game game(&viewer);
+    Game game(&viewer, mode, seed);
     
     game.Init();
 
+    if (!recordPath.empty() || !replayPath.empty()) {
+        viewer.tick_callback = [&]() { return log.Tick(viewer); };
+    }
+
     viewer.update_callback = [&]() {
         game.Update(); // update game state
     };
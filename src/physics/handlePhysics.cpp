@@ -22,14 +22,16 @@ void HandlePhysics::Update(float deltaTime) {
 
 
     for (auto obj : PhysicObject::allPhysicObjects) {
-        obj->UpdatePhysics(deltaTime);
+        if (obj->enabled) obj->UpdatePhysics(deltaTime);
     }
 
     int n = PhysicObject::allPhysicObjects.size();
     for (int i = 0; i < n; ++i) {
+        PhysicObject* objA = PhysicObject::allPhysicObjects[i];
+        if (!objA->enabled) continue;
         for (int j = i + 1; j < n; ++j) {
-            PhysicObject* objA = PhysicObject::allPhysicObjects[i];
             PhysicObject* objB = PhysicObject::allPhysicObjects[j];
+            if (!objB->enabled) continue;
 
             CollisionInfo info = PhysicObject::checkCollision(objA, objB);
             if (info.hit) {
@@ -0,0 +1,69 @@
+#include "aiLod.h"
+#include "constants.h"
+
+// initialize static variables
+uint64_t   AiLod::tick = 0;
+float      AiLod::farDistance = Config::Game::fogEndDistance;
+int        AiLod::farBudget = Config::AiLod::FAR_BUDGET;
+int        AiLod::farCursor = 0;
+int        AiLod::lastFarCount = 0;
+AiLodStats AiLod::current;
+AiLodStats AiLod::stats;
+
+void AiLod::BeginFrame(float distance) {
+    farDistance = distance;
+    current = AiLodStats();
+    current.farBudget = farBudget;
+}
+
+void AiLod::EndFrame() {
+    // the next slice starts where this one stopped
+    lastFarCount = current.farCount;
+    farCursor = lastFarCount > 0 ? (farCursor + farBudget) % lastFarCount : 0;
+
+    current.farSweepTicks = current.farCount > 0 ? (current.farCount + farBudget - 1) / farBudget : 0;
+    stats = current;
+    tick++;
+}
+
+AiRate AiLod::Classify(float distance) {
+    if (distance < Config::AiLod::NEAR_DISTANCE) return AiRate::Near;
+    if (distance < farDistance) return AiRate::Mid;
+    return AiRate::Far;
+}
+
+bool AiLod::ShouldThink(size_t index, float distance, bool hasHeading) {
+    bool think = false;
+    switch (Classify(distance)) {
+    case AiRate::Near:
+        current.nearCount++;
+        think = true;
+        break;
+    case AiRate::Mid:
+        current.midCount++;
+        think = !hasHeading || (tick + index) % Config::AiLod::MID_INTERVAL == 0;
+        break;
+    case AiRate::Far: {
+        // far enemies are numbered in the order they are met; the ones whose
+        // number falls in this tick's window think, the window moves by the
+        // budget every tick. Fresh spawns without a heading jump the queue but
+        // still count against the budget, a mass spawn is spread over ticks
+        int ordinal = current.farCount++;
+        int ring = lastFarCount > ordinal ? lastFarCount : ordinal + 1;
+        int offset = ((ordinal - farCursor) % ring + ring) % ring;
+        bool due = offset < farBudget || !hasHeading;
+        if (due && current.farThinks < farBudget) {
+            current.farThinks++;
+            think = true;
+        }
+        break;
+    }
+    }
+
+    if (think) current.thinks++;
+    return think;
+}
+
+void AiLod::SetFarBudget(int budget) {
+    farBudget = budget > 0 ? budget : 1;
+}
@@ -73,6 +73,13 @@ void Camera::ProcessMouseMovement(float xoffset, float yoffset, bool constrainPi
     updateCameraVectors();
 }
 
+void Camera::SetOrientation(float yaw, float pitch)
+{
+    Yaw = yaw;
+    Pitch = pitch;
+    updateCameraVectors();
+}
+
 void Camera::ProcessKeyboard(Camera_Movement direction, float deltaTime)
 {
     
@@ -0,0 +1,142 @@
+#include "collisionBake.h"
+#include "modelCache.h"
+#include "model.h"
+#include <cfloat>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace fs = std::filesystem;
+
+static const char BAKE_MAGIC[8] = { 'M', 'A', 'P', 'C', 'O', 'L', 'L', '\0' };
+
+struct BakeHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t boxCount;
+    uint64_t sourceSize;
+    int64_t sourceTime;
+};
+
+bool CollisionBake::Get(const std::string& sourcePath, std::vector<CollisionBox>& boxes) {
+    if (Load(sourcePath, boxes)) return true;
+    if (!Build(sourcePath, boxes)) return false;
+    Write(sourcePath, boxes);
+    return true;
+}
+
+std::string CollisionBake::BakePathFor(const std::string& sourcePath) {
+    return std::string(CACHE_DIR) + fs::path(sourcePath).stem().string() + ".collision";
+}
+
+bool CollisionBake::Load(const std::string& sourcePath, std::vector<CollisionBox>& boxes) {
+    uint64_t sourceSize;
+    int64_t sourceTime;
+    if (!ModelCache::SourceStamp(sourcePath, sourceSize, sourceTime)) return false;
+
+    std::ifstream file(BakePathFor(sourcePath), std::ios::binary);
+    if (!file.is_open()) return false;
+
+    BakeHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) return false;
+    if (std::memcmp(header.magic, BAKE_MAGIC, sizeof(BAKE_MAGIC)) != 0 || header.version != Version ||
+        header.sourceSize != sourceSize || header.sourceTime != sourceTime) {
+        std::cout << "[collision] stale bake: " << BakePathFor(sourcePath) << std::endl;
+        return false;
+    }
+
+    boxes.clear();
+    for (uint32_t i = 0; i < header.boxCount; i++) {
+        CollisionBox box;
+        uint32_t nameLength = 0;
+        float values[6];
+        if (!file.read(reinterpret_cast<char*>(&nameLength), sizeof(nameLength)) || nameLength > 4096) return false;
+        box.name.resize(nameLength);
+        if (nameLength > 0 && !file.read(&box.name[0], nameLength)) return false;
+        if (!file.read(reinterpret_cast<char*>(values), sizeof(values))) return false;
+        box.center = glm::vec3(values[0], values[1], values[2]);
+        box.size = glm::vec3(values[3], values[4], values[5]);
+        boxes.push_back(box);
+    }
+    return true;
+}
+
+bool CollisionBake::Build(const std::string& sourcePath, std::vector<CollisionBox>& boxes) {
+    // CPU import only, the collision meshes never reach the GPU
+    ModelData data;
+    if (!Model::LoadData(sourcePath, data)) return false;
+
+    boxes.clear();
+    std::vector<glm::mat4> globalTransforms(data.nodes.size());
+    for (size_t i = 0; i < data.nodes.size(); i++) {
+        const NodeRecord& node = data.nodes[i];
+        // parents are stored before their children
+        globalTransforms[i] = node.parent >= 0 ? globalTransforms[node.parent] * node.transform : node.transform;
+
+        for (uint32_t meshIndex : node.meshes) {
+            const MeshRecord& mesh = data.meshes[meshIndex];
+            if (mesh.vertexCount == 0) continue;
+
+            glm::vec3 aabbMin(FLT_MAX);
+            glm::vec3 aabbMax(-FLT_MAX);
+            for (uint32_t v = 0; v < mesh.vertexCount; v++) {
+                aabbMin = glm::min(aabbMin, mesh.vertices[v].Position);
+                aabbMax = glm::max(aabbMax, mesh.vertices[v].Position);
+            }
+
+            // only the center is transformed, colliders are axis aligned
+            CollisionBox box;
+            box.name = node.name;
+            box.size = aabbMax - aabbMin;
+            box.center = glm::vec3(globalTransforms[i] * glm::vec4((aabbMin + aabbMax) * 0.5f, 1.0f));
+            boxes.push_back(box);
+        }
+    }
+
+    std::cout << "[collision] baked " << boxes.size() << " boxes from " << sourcePath << std::endl;
+    return true;
+}
+
+bool CollisionBake::Write(const std::string& sourcePath, const std::vector<CollisionBox>& boxes) {
+    BakeHeader header;
+    std::memcpy(header.magic, BAKE_MAGIC, sizeof(BAKE_MAGIC));
+    header.version = Version;
+    header.boxCount = static_cast<uint32_t>(boxes.size());
+    if (!ModelCache::SourceStamp(sourcePath, header.sourceSize, header.sourceTime)) return false;
+
+    std::error_code error;
+    fs::create_directories(CACHE_DIR, error);
+
+    // write next to the target then rename, a crash never leaves half a bake
+    std::string bakePath = BakePathFor(sourcePath);
+    std::string tempPath = bakePath + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "[collision] can't write " << tempPath << std::endl;
+            return false;
+        }
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        for (const CollisionBox& box : boxes) {
+            uint32_t nameLength = static_cast<uint32_t>(box.name.size());
+            float values[6] = { box.center.x, box.center.y, box.center.z, box.size.x, box.size.y, box.size.z };
+            file.write(reinterpret_cast<const char*>(&nameLength), sizeof(nameLength));
+            file.write(box.name.data(), nameLength);
+            file.write(reinterpret_cast<const char*>(values), sizeof(values));
+        }
+
+        if (!file.good()) {
+            std::cerr << "[collision] write failed: " << tempPath << std::endl;
+            return false;
+        }
+    }
+
+    fs::rename(tempPath, bakePath, error);
+    if (error) {
+        fs::remove(tempPath, error);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,161 @@
+#include "crowd.h"
+#include "constants.h"
+#include <algorithm>
+#include <cmath>
+
+// initialize static variables
+const glm::vec3*       Crowd::points = nullptr;
+size_t                 Crowd::pointCount = 0;
+std::vector<uint32_t>  Crowd::cellStart;
+std::vector<uint32_t>  Crowd::entries;
+std::vector<uint32_t>  Crowd::pointBuckets;
+std::vector<uint32_t>  Crowd::cursors;
+uint32_t               Crowd::bucketMask = 0;
+
+glm::ivec2 Crowd::cellOf(glm::vec3 position) {
+    return glm::ivec2(static_cast<int>(std::floor(position.x / Config::Crowd::NEIGHBOUR_RADIUS)),
+                      static_cast<int>(std::floor(position.z / Config::Crowd::NEIGHBOUR_RADIUS)));
+}
+
+uint32_t Crowd::bucketOf(int x, int z) {
+    uint32_t h = static_cast<uint32_t>(x) * 73856093u ^ static_cast<uint32_t>(z) * 19349663u;
+    return h & bucketMask;
+}
+
+int Crowd::nearbyBuckets(glm::vec3 position, uint32_t buckets[9]) {
+    // the 9 cells can share buckets, each bucket is listed once
+    glm::ivec2 cell = cellOf(position);
+    int count = 0;
+    for (int dz = -1; dz <= 1; dz++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            uint32_t b = bucketOf(cell.x + dx, cell.y + dz);
+            bool seen = false;
+            for (int v = 0; v < count; v++) seen = seen || buckets[v] == b;
+            if (!seen) buckets[count++] = b;
+        }
+    }
+    return count;
+}
+
+void Crowd::Build(const glm::vec3* positions, size_t count) {
+    points = positions;
+    pointCount = count;
+
+    // about two buckets per enemy keeps collisions between cells rare
+    uint32_t bucketCount = 16;
+    while (bucketCount < 2 * pointCount) bucketCount <<= 1;
+    bucketMask = bucketCount - 1;
+
+    // counting sort of the enemies by bucket, the buffers only grow
+    cellStart.assign(bucketCount + 1, 0);
+    pointBuckets.resize(pointCount);
+    for (size_t i = 0; i < pointCount; i++) {
+        glm::ivec2 cell = cellOf(points[i]);
+        pointBuckets[i] = bucketOf(cell.x, cell.y);
+        cellStart[pointBuckets[i] + 1]++;
+    }
+    for (uint32_t b = 0; b < bucketCount; b++) cellStart[b + 1] += cellStart[b];
+
+    entries.resize(pointCount);
+    cursors.assign(cellStart.begin(), cellStart.end() - 1);
+    for (size_t i = 0; i < pointCount; i++) {
+        entries[cursors[pointBuckets[i]]++] = static_cast<uint32_t>(i);
+    }
+}
+
+// nearer first, then lower index
+bool Crowd::closer(const Neighbour& a, const Neighbour& b) {
+    return a.distanceSq < b.distanceSq || (a.distanceSq == b.distanceSq && a.index < b.index);
+}
+
+void Crowd::consider(size_t index, size_t other, Neighbour* nearest, int& count) {
+    glm::vec2 offset(points[index].x - points[other].x, points[index].z - points[other].z);
+    float distanceSq = glm::dot(offset, offset);
+    const float radius = Config::Crowd::NEIGHBOUR_RADIUS;
+    if (distanceSq >= radius * radius) return;
+
+    // max-heap of the closest ones, the farthest kept is on top
+    Neighbour candidate{ distanceSq, static_cast<uint32_t>(other) };
+    if (count < Config::Crowd::MAX_NEIGHBOURS) {
+        nearest[count++] = candidate;
+        std::push_heap(nearest, nearest + count, closer);
+    } else if (closer(candidate, nearest[0])) {
+        std::pop_heap(nearest, nearest + count, closer);
+        nearest[count - 1] = candidate;
+        std::push_heap(nearest, nearest + count, closer);
+    }
+}
+
+glm::vec3 Crowd::steer(size_t index, Neighbour* nearest, int count) {
+    if (count == 0) return glm::vec3(0.0f);
+
+    // summed in a fixed order, whoever found the neighbours
+    std::sort_heap(nearest, nearest + count, closer);
+
+    const float spacing = Config::Crowd::SEPARATION_DISTANCE;
+    glm::vec2 separation(0.0f), centre(0.0f);
+    for (int n = 0; n < count; n++) {
+        size_t other = nearest[n].index;
+        centre += glm::vec2(points[other].x, points[other].z);
+
+        // pushed harder the deeper the overlap, stacked enemies get a fixed nudge
+        if (nearest[n].distanceSq < spacing * spacing) {
+            glm::vec2 offset(points[index].x - points[other].x, points[index].z - points[other].z);
+            float distance = std::sqrt(nearest[n].distanceSq);
+            glm::vec2 away = distance > 1e-4f ? offset / distance
+                                              : glm::vec2(index < other ? 1.0f : -1.0f, 0.0f);
+            separation += away * (1.0f - distance / spacing);
+        }
+    }
+
+    glm::vec2 toCentre = centre / static_cast<float>(count) - glm::vec2(points[index].x, points[index].z);
+    glm::vec2 steering = separation * Config::Crowd::SEPARATION_WEIGHT
+                       + toCentre * Config::Crowd::COHESION_WEIGHT;
+
+    float length = glm::length(steering);
+    if (length > 1.0f) steering /= length;
+    return glm::vec3(steering.x, 0.0f, steering.y);
+}
+
+glm::vec3 Crowd::Steering(size_t index) {
+    if (index >= pointCount) return glm::vec3(0.0f);
+
+    // the 3x3 cells hold every neighbour within the radius
+    Neighbour nearest[Config::Crowd::MAX_NEIGHBOURS];
+    int count = 0;
+    uint32_t buckets[9];
+    int bucketCount = nearbyBuckets(points[index], buckets);
+    for (int i = 0; i < bucketCount; i++) {
+        uint32_t b = buckets[i];
+        for (uint32_t e = cellStart[b]; e < cellStart[b + 1]; e++) {
+            if (entries[e] != index) consider(index, entries[e], nearest, count);
+        }
+    }
+    return steer(index, nearest, count);
+}
+
+glm::vec3 Crowd::SteeringBruteForce(size_t index) {
+    if (index >= pointCount) return glm::vec3(0.0f);
+
+    Neighbour nearest[Config::Crowd::MAX_NEIGHBOURS];
+    int count = 0;
+    for (size_t other = 0; other < pointCount; other++) {
+        if (other != index) consider(index, other, nearest, count);
+    }
+    return steer(index, nearest, count);
+}
+
+void Crowd::Query(glm::vec3 position, float radius, std::vector<uint32_t>& out) {
+    out.clear();
+    if (pointCount == 0) return;
+
+    uint32_t buckets[9];
+    int bucketCount = nearbyBuckets(position, buckets);
+    for (int i = 0; i < bucketCount; i++) {
+        uint32_t b = buckets[i];
+        for (uint32_t e = cellStart[b]; e < cellStart[b + 1]; e++) {
+            glm::vec2 offset(points[entries[e]].x - position.x, points[entries[e]].z - position.z);
+            if (glm::dot(offset, offset) < radius * radius) out.push_back(entries[e]);
+        }
+    }
+}
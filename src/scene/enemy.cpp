@@ -2,9 +2,23 @@
 #include "player.h"
 #include "projectile.h"
 #include "sphere.h"
+#include "flowField.h"
 
 Enemy::Enemy(Shape* shape, glm::vec3 position, Shader* projectileShader)
-    : PhysicShapeObject(shape, position), health(100), power(10) {
+    : PhysicShapeObject(shape, position), health(100), maxHealth(100), power(10), attackCooldown(0.0f) {
+}
+
+void Enemy::Reset(glm::vec3 position) {
+    Position = position;
+    Velocity = glm::vec3(0.0f);
+    Acceleration = glm::vec3(0.0f);
+    forcesApplied = glm::vec3(0.0f);
+    RotationMatrix = glm::mat4(1.0f);
+
+    health = maxHealth;
+    attackCooldown = 0.0f;
+    heading = glm::vec3(0.0f);
+    enabled = true;
 }
 
 Enemy::~Enemy() {
@@ -26,7 +40,7 @@ void Enemy::BeforeCollide(PhysicObject* other, CollisionInfo info, float deltaTi
             proj->deactivate();
             return;
         }
-		std::vector<Enemy*> piercedEnemies = proj->getPiercedEnemies();
+		const std::vector<Enemy*>& piercedEnemies = proj->getPiercedEnemies();
 		if (std::find(piercedEnemies.begin(), piercedEnemies.end(), this) == piercedEnemies.end()) {
             proj->addPiercedEnemy(this);
 			proj->reducePierce(1);
@@ -35,12 +49,36 @@ void Enemy::BeforeCollide(PhysicObject* other, CollisionInfo info, float deltaTi
 }
 
 
-void Enemy::moveTowardsPlayer(glm::vec3 playerPosition, float deltaTime, bool isAffraid) {
-    glm::vec3 direction = glm::normalize(playerPosition+glm::vec3(0.0f, 0.35f, 0.0f) - this->Position);
+void Enemy::moveTowardsPlayer(glm::vec3 playerPosition, float deltaTime, bool isAffraid, glm::vec3 steering) {
+    think(playerPosition, isAffraid, steering);
+    advance(deltaTime);
+}
+
+void Enemy::think(glm::vec3 playerPosition, bool isAffraid, glm::vec3 steering) {
+    heading = ChaseDirection(this->Position, playerPosition, isAffraid, steering);
+}
+
+glm::vec3 Enemy::ChaseDirection(glm::vec3 position, glm::vec3 playerPosition, bool isAffraid, glm::vec3 steering) {
+    glm::vec3 toPlayer = playerPosition + glm::vec3(0.0f, 0.35f, 0.0f) - position;
+    float distance = glm::length(toPlayer);
+    glm::vec3 direction = distance > 1e-4f ? toPlayer / distance : glm::vec3(0.0f);
+
+    // around walls the shared flow field gives the way, the height still
+    // follows the player; in the player's cell or off the grid, go straight
+    glm::vec2 flow;
+    if (FlowField::Sample(position, flow)) {
+        float horizontal = glm::length(glm::vec2(direction.x, direction.z));
+        direction = glm::vec3(flow.x * horizontal, direction.y, flow.y * horizontal);
+    }
     if (isAffraid) {
         direction = -direction;
     }
-    this->Position += direction * speed * deltaTime; 
+
+    // crowd steering bends the path, never faster than the enemy's speed
+    direction += steering;
+    float length = glm::length(direction);
+    if (length > 1.0f) direction /= length;
+    return direction;
 }
 
 void Enemy::setModel(Node* modelNode) {
@@ -56,7 +94,8 @@ void Enemy::draw(glm::mat4& view, glm::mat4& projection) {
     glm::mat4 rotation = glm::inverse(glm::lookAt(glm::vec3(0.0f), this->GetFrontVector(), glm::vec3(0.0f, 1.0f, 0.0f)));
     model = model * rotation;
 
-    this->model->draw(model, view, projection);
+    // every ghost of a tier shares the same meshes, batch them
+    this->model->submitInstances(model, view, projection);
 }
 
 void Enemy::attack(Player* player , float deltaTime) {
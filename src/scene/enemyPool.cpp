@@ -0,0 +1,76 @@
+#include "enemyPool.h"
+#include "enemy.h"
+#include "entityLoader.h"
+#include "constants.h"
+#include "node.h"
+
+// initialize static variables
+Node*               EnemyPool::sceneRoot = nullptr;
+std::vector<Enemy*> EnemyPool::freeLists[EnemyPool::TierCount];
+size_t              EnemyPool::created[EnemyPool::TierCount] = { 0, 0, 0, 0 };
+
+void EnemyPool::Init(Node* root) {
+    sceneRoot = root;
+    for (std::vector<Enemy*>& freeList : freeLists) {
+        freeList.reserve(Config::EnemySpawner::MAX_ENEMIES);
+    }
+}
+
+int EnemyPool::slot(int tier) {
+    // unknown tiers fall back to tier 1, like EntityLoader::CreateEnemy
+    return (tier >= 1 && tier <= TierCount) ? tier - 1 : 0;
+}
+
+Enemy* EnemyPool::create(int tier) {
+    // registered in the scene once, for the whole life of the enemy
+    Enemy* enemy = EntityLoader::CreateEnemy(glm::vec3(0.0f), slot(tier) + 1);
+    sceneRoot->add(enemy);
+    created[slot(tier)]++;
+    return enemy;
+}
+
+void EnemyPool::Prewarm(int tier, int count) {
+    std::vector<Enemy*>& freeList = freeLists[slot(tier)];
+    for (int i = 0; i < count; i++) {
+        Enemy* enemy = create(tier);
+        enemy->enabled = false;
+        freeList.push_back(enemy);
+    }
+}
+
+Enemy* EnemyPool::Acquire(int tier, glm::vec3 position) {
+    std::vector<Enemy*>& freeList = freeLists[slot(tier)];
+    Enemy* enemy;
+    if (freeList.empty()) {
+        enemy = create(tier);
+    } else {
+        enemy = freeList.back();
+        freeList.pop_back();
+    }
+    enemy->Reset(position);
+    return enemy;
+}
+
+void EnemyPool::Release(Enemy* enemy) {
+    enemy->enabled = false;
+    freeLists[slot(enemy->getTier())].push_back(enemy);
+}
+
+void EnemyPool::Clear() {
+    for (int i = 0; i < TierCount; i++) {
+        for (Enemy* enemy : freeLists[i]) {
+            sceneRoot->remove(enemy);
+            delete enemy;
+        }
+        created[i] -= freeLists[i].size();
+        freeLists[i].clear();
+    }
+}
+
+size_t EnemyPool::FreeCount(int tier) {
+    return freeLists[slot(tier)].size();
+}
+
+size_t EnemyPool::CreatedCount(int tier) {
+    return created[slot(tier)];
+}
@@ -1,20 +1,18 @@
 #include "enemySpawner.h"
 #include "enemy.h"
-#include "entityLoader.h"
+#include "enemyPool.h"
 #include "constants.h"
-#include <cstdlib>
-#include <ctime>
+#include <cmath>
 
-EnemySpawner::EnemySpawner(Node* sceneRoot, glm::vec3 position, std::vector<Enemy*>& enemyList)
-    : PhysicShapeObject(nullptr, position), timeSinceLastSpawn(0.0f), sceneRoot(sceneRoot), enemyList(enemyList) {
-    std::srand(static_cast<unsigned int>(std::time(nullptr))); // Seed for randomness
+EnemySpawner::EnemySpawner(Node* sceneRoot, glm::vec3 position, std::vector<Enemy*>& enemyList, uint64_t seed)
+    : PhysicShapeObject(nullptr, position), random(seed), timeSinceLastSpawn(0.0f), sceneRoot(sceneRoot), enemyList(enemyList) {
 }
 
 void EnemySpawner::SpawnEnemy() {
     if (enemyList.size() >= Config::EnemySpawner::MAX_ENEMIES) {
         return;
     }
-    float randValue = static_cast<float>(std::rand()) / RAND_MAX;
+    float randValue = random.NextFloat();
     float cumulativeProbability = 0.0f;
     int tier = 1;
     for (size_t i = 0; i < spawnProbabilities.size(); ++i) {
@@ -26,18 +24,18 @@ void EnemySpawner::SpawnEnemy() {
     }
 
     // random position within radius around spawner position
-    float angle = static_cast<float>(std::rand()) / RAND_MAX * 2.0f * 3.14159265f;
-    float random01 = static_cast<float>(std::rand()) / RAND_MAX;
+    float angle = random.NextFloat() * 2.0f * 3.14159265f;
+    float random01 = random.NextFloat();
     float distance = std::sqrt(random01) * (radius-noSpawnRadius) + noSpawnRadius;
 
     glm::vec3 offset = glm::vec3(std::cos(angle) * distance, 0.0f, std::sin(angle) * distance);
 
     glm::vec3 finalPos = Position + offset;
 
-    Enemy* newEnemy = EntityLoader::CreateEnemy(finalPos, tier);
+    // recycled from the pool, already part of the scene
+    Enemy* newEnemy = EnemyPool::Acquire(tier, finalPos);
 
     enemyList.push_back(newEnemy);
-    sceneRoot->add(newEnemy);
 }
 
 void EnemySpawner::updateSpawnProbabilities(int playerLevel) {
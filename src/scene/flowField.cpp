@@ -0,0 +1,246 @@
+#include "flowField.h"
+#include "constants.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+// 8 neighbours, straight ones first so ties prefer them
+static const int NEIGHBOUR_X[8] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+static const int NEIGHBOUR_Z[8] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+static const glm::vec2 NEIGHBOUR_DIRECTION[8] = {
+    glm::vec2(1.0f, 0.0f), glm::vec2(-1.0f, 0.0f), glm::vec2(0.0f, 1.0f), glm::vec2(0.0f, -1.0f),
+    glm::vec2(0.70710678f, 0.70710678f), glm::vec2(0.70710678f, -0.70710678f),
+    glm::vec2(-0.70710678f, 0.70710678f), glm::vec2(-0.70710678f, -0.70710678f)
+};
+
+// initialize static variables
+glm::vec2            FlowField::origin(0.0f);
+int                  FlowField::width = 0;
+int                  FlowField::depth = 0;
+std::vector<uint8_t> FlowField::blocked;
+std::vector<uint8_t> FlowField::escape;
+std::vector<uint32_t> FlowField::distance;
+std::vector<uint32_t> FlowField::stamp;
+std::vector<uint8_t> FlowField::directions;
+uint32_t             FlowField::wave = 0;
+std::deque<int>      FlowField::frontier;
+int                  FlowField::targetCell = -1;
+bool                 FlowField::published = false;
+std::vector<uint32_t> FlowField::sampledDistance;
+std::vector<uint8_t> FlowField::sampledDirections;
+int                  FlowField::sampledTarget = -1;
+
+void FlowField::Build(const std::vector<CollisionBox>& boxes) {
+    Clear();
+    if (boxes.empty()) return;
+
+    const float cellSize = Config::Navigation::CELL_SIZE;
+
+    // the floor is the box with the largest footprint, anything rising a step
+    // above it and starting below head height is an obstacle
+    glm::vec2 minXZ(FLT_MAX), maxXZ(-FLT_MAX);
+    float floorTop = 0.0f, floorArea = -1.0f;
+    for (const CollisionBox& box : boxes) {
+        glm::vec3 half = box.size * 0.5f;
+        minXZ = glm::min(minXZ, glm::vec2(box.center.x - half.x, box.center.z - half.z));
+        maxXZ = glm::max(maxXZ, glm::vec2(box.center.x + half.x, box.center.z + half.z));
+        float area = box.size.x * box.size.z;
+        if (area > floorArea) {
+            floorArea = area;
+            floorTop = box.center.y + half.y;
+        }
+    }
+
+    origin = minXZ;
+    width = std::max(1, static_cast<int>(std::ceil((maxXZ.x - minXZ.x) / cellSize)));
+    depth = std::max(1, static_cast<int>(std::ceil((maxXZ.y - minXZ.y) / cellSize)));
+    blocked.assign(static_cast<size_t>(width) * depth, 0);
+
+    float lowest = floorTop + Config::Navigation::STEP_HEIGHT;
+    float highest = floorTop + Config::Enemy::HEIGHT;
+    float margin = Config::Enemy::RADIUS; // obstacles grow by the enemy radius
+    for (const CollisionBox& box : boxes) {
+        glm::vec3 half = box.size * 0.5f;
+        if (box.center.y + half.y <= lowest || box.center.y - half.y >= highest) continue;
+
+        int x0 = std::max(0, static_cast<int>(std::floor((box.center.x - half.x - margin - origin.x) / cellSize)));
+        int x1 = std::min(width - 1, static_cast<int>(std::floor((box.center.x + half.x + margin - origin.x) / cellSize)));
+        int z0 = std::max(0, static_cast<int>(std::floor((box.center.z - half.z - margin - origin.y) / cellSize)));
+        int z1 = std::min(depth - 1, static_cast<int>(std::floor((box.center.z + half.z + margin - origin.y) / cellSize)));
+        for (int z = z0; z <= z1; z++) {
+            for (int x = x0; x <= x1; x++) blocked[z * width + x] = 1;
+        }
+    }
+
+    distance.assign(blocked.size(), 0);
+    stamp.assign(blocked.size(), 0);
+    directions.assign(blocked.size(), NoDirection);
+    sampledDistance.assign(blocked.size(), UINT32_MAX);
+    sampledDirections.assign(blocked.size(), NoDirection);
+    buildEscape();
+}
+
+void FlowField::buildEscape() {
+    // a wave from every walkable cell at once into the blocked ones, each
+    // blocked cell points back at the cell that reached it
+    escape.assign(blocked.size(), NoDirection);
+    std::deque<int> open;
+    for (int cell = 0; cell < static_cast<int>(blocked.size()); cell++) {
+        if (!blocked[cell]) open.push_back(cell);
+    }
+
+    while (!open.empty()) {
+        int cell = open.front();
+        open.pop_front();
+        int x = cell % width;
+        int z = cell / width;
+        for (uint8_t i = 0; i < 4; i++) {
+            int nx = x + NEIGHBOUR_X[i];
+            int nz = z + NEIGHBOUR_Z[i];
+            if (nx < 0 || nz < 0 || nx >= width || nz >= depth) continue;
+
+            int neighbour = nz * width + nx;
+            if (!blocked[neighbour] || escape[neighbour] != NoDirection) continue;
+            escape[neighbour] = i ^ 1; // opposite direction, pairs are adjacent in the table
+            open.push_back(neighbour);
+        }
+    }
+}
+
+void FlowField::Clear() {
+    width = depth = 0;
+    std::vector<uint8_t>().swap(blocked);
+    std::vector<uint8_t>().swap(escape);
+    std::vector<uint32_t>().swap(distance);
+    std::vector<uint32_t>().swap(stamp);
+    std::vector<uint8_t>().swap(directions);
+    std::vector<uint32_t>().swap(sampledDistance);
+    std::vector<uint8_t>().swap(sampledDirections);
+    frontier.clear();
+    wave = 0;
+    targetCell = -1;
+    sampledTarget = -1;
+    published = false;
+}
+
+int FlowField::cellAt(glm::vec3 position) {
+    int x = static_cast<int>(std::floor((position.x - origin.x) / Config::Navigation::CELL_SIZE));
+    int z = static_cast<int>(std::floor((position.z - origin.y) / Config::Navigation::CELL_SIZE));
+    if (x < 0 || z < 0 || x >= width || z >= depth) return -1;
+    return z * width + x;
+}
+
+bool FlowField::walkable(int x, int z) {
+    return x >= 0 && z >= 0 && x < width && z < depth && !blocked[z * width + x];
+}
+
+void FlowField::Update(glm::vec3 playerPosition) {
+    if (!IsBuilt()) return;
+
+    // a wave runs to the end before the next one starts, a player crossing
+    // cells faster than a wave expands still gets a field now and then
+    int cell = cellAt(playerPosition);
+    if (frontier.empty() && cell != targetCell) {
+        // bumping the stamp invalidates every cell without clearing
+        targetCell = cell;
+        wave++;
+        published = false;
+        if (cell >= 0) {
+            stamp[cell] = wave;
+            distance[cell] = 0;
+            directions[cell] = NoDirection;
+            frontier.push_back(cell);
+        }
+    }
+
+    for (int budget = Config::Navigation::CELLS_PER_FRAME; budget > 0 && !frontier.empty(); budget--) {
+        int next = frontier.front();
+        frontier.pop_front();
+        expand(next);
+    }
+
+    if (frontier.empty() && !published) publish();
+}
+
+void FlowField::publish() {
+    for (size_t cell = 0; cell < blocked.size(); cell++) {
+        bool reached = stamp[cell] == wave;
+        sampledDistance[cell] = reached ? distance[cell] : UINT32_MAX;
+        sampledDirections[cell] = reached ? directions[cell] : NoDirection;
+    }
+    sampledTarget = targetCell;
+    published = true;
+}
+
+void FlowField::expand(int cell) {
+    int x = cell % width;
+    int z = cell / width;
+
+    // point at the closest neighbour already reached, cells one step closer
+    // are all known once this one is popped; diagonals never cut a corner
+    uint32_t best = distance[cell];
+    uint8_t bestDirection = NoDirection;
+    for (uint8_t i = 0; i < 8; i++) {
+        int nx = x + NEIGHBOUR_X[i];
+        int nz = z + NEIGHBOUR_Z[i];
+        if (!walkable(nx, nz)) continue;
+        if (i >= 4 && (!walkable(nx, z) || !walkable(x, nz))) continue;
+
+        int neighbour = nz * width + nx;
+        if (stamp[neighbour] == wave && distance[neighbour] < best) {
+            best = distance[neighbour];
+            bestDirection = i;
+        }
+    }
+    if (cell != targetCell) directions[cell] = bestDirection;
+
+    // 4-connected wave, every step costs the same
+    for (int i = 0; i < 4; i++) {
+        int nx = x + NEIGHBOUR_X[i];
+        int nz = z + NEIGHBOUR_Z[i];
+        if (!walkable(nx, nz)) continue;
+
+        int neighbour = nz * width + nx;
+        if (stamp[neighbour] == wave) continue;
+        stamp[neighbour] = wave;
+        distance[neighbour] = distance[cell] + 1;
+        directions[neighbour] = NoDirection;
+        frontier.push_back(neighbour);
+    }
+}
+
+bool FlowField::Sample(glm::vec3 position, glm::vec2& direction) {
+    if (!IsBuilt()) return false;
+
+    int cell = cellAt(position);
+    if (cell < 0 || cell == sampledTarget) return false;
+
+    if (blocked[cell]) {
+        // step onto the reached neighbour closest to the player, diagonals
+        // included since the enemy is already inside the margin
+        int x = cell % width;
+        int z = cell / width;
+        uint32_t best = UINT32_MAX;
+        uint8_t bestDirection = NoDirection;
+        for (uint8_t i = 0; i < 8; i++) {
+            int nx = x + NEIGHBOUR_X[i];
+            int nz = z + NEIGHBOUR_Z[i];
+            if (!walkable(nx, nz)) continue;
+
+            int neighbour = nz * width + nx;
+            if (sampledDistance[neighbour] < best) {
+                best = sampledDistance[neighbour];
+                bestDirection = i;
+            }
+        }
+        // deeper in, or next to cells the wave has not reached: get out first
+        if (bestDirection == NoDirection) bestDirection = escape[cell];
+        if (bestDirection == NoDirection) return false;
+        direction = NEIGHBOUR_DIRECTION[bestDirection];
+        return true;
+    }
+    uint8_t index = sampledDirections[cell];
+    if (index == NoDirection) return false;
+    direction = NEIGHBOUR_DIRECTION[index];
+    return true;
+}
@@ -0,0 +1,313 @@
+#include "horde.h"
+#include "constants.h"
+#include "crowd.h"
+#include "aiLod.h"
+#include "enemy.h"
+#include "enemySpawner.h"
+#include "capsule.h"
+#include "model.h"
+#include "node.h"
+#include "physicShapeObject.h"
+#include "projectile.h"
+#include "resourceManager.h"
+#include "renderQueue.h"
+#include "instancedRenderer.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <cmath>
+#include <string>
+
+// same stats as EntityLoader::CreateEnemy, by tier
+struct HordeTier {
+    float speed;
+    float attackSpeed;
+    float power;
+    float maxHealth;
+    float experience;
+    glm::vec3 color; // capsule drawn when the ghost model is missing
+};
+
+static const HordeTier TIERS[Horde::TierCount] = {
+    { 2.0f,  1.0f, 10.0f, 20.0f,  10.0f,  glm::vec3(0.7f, 0.7f, 0.9f) },
+    { 3.0f,  1.5f, 20.0f, 45.0f,  25.0f,  glm::vec3(0.5f, 0.8f, 0.6f) },
+    { 3.75f, 2.0f, 30.0f, 120.0f, 75.0f,  glm::vec3(0.9f, 0.6f, 0.3f) },
+    { 4.25f, 2.5f, 40.0f, 400.0f, 300.0f, glm::vec3(0.9f, 0.2f, 0.2f) },
+};
+
+// draws the horde when the scene graph reaches it, in the shadow and main passes
+class HordeRenderer : public PhysicShapeObject {
+public:
+    HordeRenderer() : PhysicShapeObject(nullptr) {
+        SetMass(0.0f);
+        name = "Horde";
+    }
+
+    void draw(glm::mat4& view, glm::mat4& projection) override {
+        Horde::Submit(view, projection);
+    }
+};
+
+// initialize static variables
+std::vector<glm::vec3>   Horde::positions;
+std::vector<glm::vec3>   Horde::headings;
+std::vector<glm::vec2>   Horde::facings;
+std::vector<float>       Horde::health;
+std::vector<float>       Horde::cooldowns;
+std::vector<uint8_t>     Horde::tiers;
+std::vector<uint32_t>    Horde::ids;
+uint32_t                 Horde::nextId = 0;
+std::vector<HordeDeath>  Horde::deaths;
+std::vector<Horde::Part> Horde::parts[Horde::TierCount];
+Node*                    Horde::ghostNodes[Horde::TierCount] = {};
+std::vector<glm::mat4>   Horde::instances[Horde::TierCount];
+bool                     Horde::instancesDirty = true;
+float                    Horde::spawnBudget = 0.0f;
+Random                   Horde::random;
+std::vector<uint32_t>    Horde::hits;
+
+void Horde::Init(Node* sceneRoot, uint64_t seed) {
+    random.Seed(seed);
+
+    size_t capacity = static_cast<size_t>(Config::Horde::MAX_ENEMIES);
+    positions.reserve(capacity);
+    headings.reserve(capacity);
+    facings.reserve(capacity);
+    health.reserve(capacity);
+    cooldowns.reserve(capacity);
+    tiers.reserve(capacity);
+    ids.reserve(capacity);
+
+    // the ghost models are shared with the classic mode, placed and faded the same way
+    Shader* shader = ResourceManager::GetShader("standard");
+    glm::mat4 placement = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, -1.0f, 0.0f));
+    Shutdown();
+    for (int t = 0; t < TierCount; t++) {
+        Model* ghost = ResourceManager::GetModel("ghostT" + std::to_string(t + 1));
+        if (ghost && ghost->rootNode) {
+            ghostNodes[t] = ghost->rootNode->clone();
+            ghostNodes[t]->set_transform(placement);
+            ghostNodes[t]->setAlpha(0.2f);
+            collectParts(ghostNodes[t], glm::mat4(1.0f), parts[t]);
+        }
+        if (parts[t].empty()) {
+            delete ghostNodes[t];
+            ghostNodes[t] = nullptr;
+
+            Capsule* capsule = new Capsule(shader, Config::Enemy::RADIUS, Config::Enemy::HEIGHT);
+            capsule->color = TIERS[t].color;
+            parts[t].push_back(Part{ capsule, glm::mat4(1.0f) });
+        }
+    }
+
+    sceneRoot->add(new HordeRenderer());
+}
+
+void Horde::collectParts(Node* node, const glm::mat4& parent, std::vector<Part>& out) {
+    glm::mat4 local = parent * node->get_transform();
+    for (Shape* shape : node->getShapes()) {
+        out.push_back(Part{ shape, local });
+    }
+    for (Node* child : node->children_) {
+        collectParts(child, local, out);
+    }
+}
+
+void Horde::Clear() {
+    positions.clear();
+    headings.clear();
+    facings.clear();
+    health.clear();
+    cooldowns.clear();
+    tiers.clear();
+    ids.clear(); // nextId goes on, shots still flying keep their lists
+    deaths.clear();
+    spawnBudget = 0.0f;
+    instancesDirty = true;
+}
+
+void Horde::Shutdown() {
+    Clear();
+    for (int t = 0; t < TierCount; t++) {
+        // a model copy deletes its shapes, a fallback capsule is the only part
+        if (ghostNodes[t]) {
+            delete ghostNodes[t];
+            ghostNodes[t] = nullptr;
+        } else {
+            for (const Part& part : parts[t]) delete part.shape;
+        }
+        parts[t].clear();
+        instances[t].clear();
+    }
+}
+
+bool Horde::Spawn(int tier, glm::vec3 position) {
+    if (positions.size() >= static_cast<size_t>(Config::Horde::MAX_ENEMIES)) return false;
+    tier = glm::clamp(tier, 1, TierCount);
+
+    positions.push_back(position);
+    headings.push_back(glm::vec3(0.0f));
+    facings.push_back(glm::vec2(0.0f, 1.0f));
+    health.push_back(TIERS[tier - 1].maxHealth);
+    cooldowns.push_back(0.0f);
+    tiers.push_back(static_cast<uint8_t>(tier - 1));
+    ids.push_back(nextId++);
+    instancesDirty = true;
+    return true;
+}
+
+void Horde::SpawnAround(float deltaTime, glm::vec3 target) {
+    spawnBudget += deltaTime * Config::Horde::SPAWN_PER_SECOND;
+    if (spawnBudget < 1.0f) return;
+
+    // tiers are drawn like the classic spawner's
+    std::vector<float> probabilities = EnemySpawner::getSpawnProbabilities();
+    while (spawnBudget >= 1.0f) {
+        spawnBudget -= 1.0f;
+
+        float pick = random.NextFloat();
+        int tier = TierCount;
+        for (size_t i = 0; i < probabilities.size(); i++) {
+            pick -= probabilities[i];
+            if (pick < 0.0f) {
+                tier = static_cast<int>(i) + 1;
+                break;
+            }
+        }
+
+        float angle = random.NextFloat() * 6.28318531f;
+        float distance = Config::Horde::SPAWN_MIN_RADIUS
+                       + std::sqrt(random.NextFloat()) * (Config::Horde::SPAWN_MAX_RADIUS - Config::Horde::SPAWN_MIN_RADIUS);
+        if (!Spawn(tier, target + glm::vec3(std::cos(angle) * distance, 0.0f, std::sin(angle) * distance))) {
+            spawnBudget = 0.0f;
+            return;
+        }
+    }
+}
+
+float Horde::Update(float deltaTime, glm::vec3 target, bool isAffraid) {
+    // one pass over the arrays: plan at the AiLod rate on a grid of last
+    // frame's positions, move every ghost along its heading, attack. The grid
+    // reads the array in place, ghosts already moved this pass are seen where
+    // they are now
+    Crowd::Build(positions.data(), positions.size());
+
+    const float reach = Config::Enemy::RADIUS + Config::Player::capsuleRadius + Config::Horde::ATTACK_MARGIN;
+    float damage = 0.0f;
+    for (size_t i = 0; i < positions.size(); i++) {
+        const HordeTier& stats = TIERS[tiers[i]];
+        glm::vec3 offset = target - positions[i];
+        bool planned = headings[i] != glm::vec3(0.0f);
+        if (AiLod::ShouldThink(i, glm::length(offset), planned)) {
+            headings[i] = Enemy::ChaseDirection(positions[i], target, isAffraid, Crowd::Steering(i));
+
+            glm::vec2 flat(headings[i].x, headings[i].z);
+            float flatLength = glm::length(flat);
+            if (flatLength > 1e-4f) facings[i] = flat / flatLength;
+        }
+        positions[i] += headings[i] * stats.speed * deltaTime;
+
+        offset = target - positions[i];
+        cooldowns[i] -= deltaTime;
+        if (cooldowns[i] <= 0.0f && offset.x * offset.x + offset.z * offset.z < reach * reach
+            && std::abs(offset.y) < Config::Enemy::HEIGHT) {
+            damage += stats.power;
+            cooldowns[i] = 1.0f / stats.attackSpeed;
+        }
+    }
+
+    instancesDirty = true;
+    return damage;
+}
+
+void Horde::ApplyHits(const std::vector<Projectile*>& projectiles) {
+    deaths.clear();
+
+    // the grid buckets are from before this frame's move, the query is
+    // widened by that move and the exact test uses the current positions
+    const float hitRadius = Config::Enemy::RADIUS + Config::Horde::PROJECTILE_RADIUS;
+    for (Projectile* proj : projectiles) {
+        if (!proj->isActive()) continue;
+
+        Crowd::Query(proj->Position, hitRadius + Config::Horde::QUERY_MARGIN, hits);
+        for (uint32_t index : hits) {
+            if (index >= positions.size() || health[index] <= 0.0f) continue;
+
+            glm::vec3 offset = proj->Position - positions[index];
+            if (offset.x * offset.x + offset.z * offset.z >= hitRadius * hitRadius) continue;
+            if (std::abs(offset.y) >= Config::Enemy::HEIGHT * 0.5f + Config::Horde::PROJECTILE_RADIUS) continue;
+            // a piercing shot stays inside a ghost for several frames
+            if (proj->hasPiercedGhost(ids[index])) continue;
+
+            health[index] -= proj->getDamage();
+            if (proj->getPierce() <= 0) {
+                proj->deactivate();
+                break;
+            }
+            proj->addPiercedGhost(ids[index]);
+            proj->reducePierce(1);
+        }
+    }
+
+    // swap-remove keeps the arrays dense, order does not matter
+    for (size_t i = 0; i < positions.size(); ) {
+        if (health[i] <= 0.0f) {
+            int tier = tiers[i] + 1;
+            deaths.push_back(HordeDeath{ positions[i], 1.2f / static_cast<float>(tier), TIERS[tiers[i]].experience });
+            remove(i);
+        } else {
+            i++;
+        }
+    }
+    if (!deaths.empty()) instancesDirty = true;
+}
+
+void Horde::remove(size_t index) {
+    size_t last = positions.size() - 1;
+    positions[index] = positions[last];
+    headings[index] = headings[last];
+    facings[index] = facings[last];
+    health[index] = health[last];
+    cooldowns[index] = cooldowns[last];
+    tiers[index] = tiers[last];
+    ids[index] = ids[last];
+
+    positions.pop_back();
+    headings.pop_back();
+    facings.pop_back();
+    health.pop_back();
+    cooldowns.pop_back();
+    tiers.pop_back();
+    ids.pop_back();
+}
+
+void Horde::BuildInstances() {
+    for (int t = 0; t < TierCount; t++) instances[t].clear();
+
+    // same pose as Enemy::draw: lifted a bit, turned away from its heading
+    for (size_t i = 0; i < positions.size(); i++) {
+        glm::vec2 f = facings[i];
+        glm::mat4 model(1.0f);
+        model[0] = glm::vec4(f.y, 0.0f, -f.x, 0.0f);
+        model[1] = glm::vec4(0.0f, 1.0f, 0.0f, 0.0f);
+        model[2] = glm::vec4(f.x, 0.0f, f.y, 0.0f);
+        model[3] = glm::vec4(positions[i] + glm::vec3(0.0f, 0.4f, 0.0f), 1.0f);
+        instances[tiers[i]].push_back(model);
+    }
+    instancesDirty = false;
+}
+
+void Horde::Submit(glm::mat4& view, glm::mat4& projection) {
+    if (instancesDirty) BuildInstances();
+
+    for (int t = 0; t < TierCount; t++) {
+        if (instances[t].empty()) continue;
+        for (const Part& part : parts[t]) {
+            if (InstancedRenderer::SubmitMany(part.shape, instances[t].data(), instances[t].size(), part.local)) continue;
+
+            // instancing off: one draw per ghost, slow but correct
+            for (const glm::mat4& ghost : instances[t]) {
+                glm::mat4 model = ghost * part.local;
+                if (!RenderQueue::Submit(part.shape, model)) part.shape->draw(model, view, projection);
+            }
+        }
+    }
+}
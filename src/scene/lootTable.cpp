@@ -0,0 +1,85 @@
+#include "lootTable.h"
+#include <cmath>
+
+// timed items grant the effect of the same name, instant ones none
+static LootInfo lootItem(const char* name, float weight, glm::vec3 color, float lifetime) {
+    StatusEffect effect = lifetime > 0.0f ? StatusEffectFromName(name) : StatusEffect::None;
+    return { name, weight, color, lifetime, effect };
+}
+
+// initialize static variables
+const LootInfo LootTable::items[LootTable::ItemCount] = {
+    lootItem("",            1.0f, glm::vec3(0.0f),               0.0f),
+    lootItem("DamageBoost", 4.0f, glm::vec3(1.0f, 0.0f, 0.0f),   10.0f),
+    lootItem("SpeedBoost",  2.0f, glm::vec3(1.0f, 1.0f, 0.0f),   10.0f),
+    lootItem("HealthPack",  2.5f, glm::vec3(0.0f, 1.0f, 0.0f),   0.0f),
+    lootItem("Fear",        5.5f, glm::vec3(0.33f, 0.1f, 0.47f), 5.0f),
+};
+std::vector<std::pair<float, AliasTable>> LootTable::tables;
+
+void AliasTable::Build(const double* probabilities, size_t count) {
+    threshold.assign(count, 1.0f);
+    alias.resize(count);
+    for (size_t i = 0; i < count; i++) alias[i] = static_cast<uint32_t>(i);
+
+    // scaled so the average column holds exactly 1
+    std::vector<double> scaled(count);
+    std::vector<uint32_t> small, large;
+    for (size_t i = 0; i < count; i++) {
+        scaled[i] = probabilities[i] * static_cast<double>(count);
+        (scaled[i] < 1.0 ? small : large).push_back(static_cast<uint32_t>(i));
+    }
+
+    // each small column is topped up by one large column
+    while (!small.empty() && !large.empty()) {
+        uint32_t less = small.back();
+        small.pop_back();
+        uint32_t more = large.back();
+        large.pop_back();
+
+        threshold[less] = static_cast<float>(scaled[less]);
+        alias[less] = more;
+
+        scaled[more] = (scaled[more] + scaled[less]) - 1.0;
+        (scaled[more] < 1.0 ? small : large).push_back(more);
+    }
+
+    // what is left is 1 up to rounding
+    for (uint32_t i : large) threshold[i] = 1.0f;
+    for (uint32_t i : small) threshold[i] = 1.0f;
+}
+
+size_t AliasTable::Sample(Random& random) const {
+    uint32_t column = random.NextBelow(static_cast<uint32_t>(threshold.size()));
+    return random.NextFloat() < threshold[column] ? column : alias[column];
+}
+
+const LootInfo& LootTable::Info(LootItem item) {
+    return items[static_cast<size_t>(item)];
+}
+
+void LootTable::Probabilities(float rarity, double out[ItemCount]) {
+    double total = 0.0;
+    for (size_t i = 0; i < ItemCount; i++) {
+        out[i] = std::exp(-1.0 * rarity * items[i].weight);
+        total += out[i];
+    }
+    for (size_t i = 0; i < ItemCount; i++) {
+        out[i] /= total;
+    }
+}
+
+LootItem LootTable::Sample(float rarity, Random& random) {
+    // one coefficient per enemy tier, a linear search is enough
+    for (const auto& table : tables) {
+        if (table.first == rarity) {
+            return static_cast<LootItem>(table.second.Sample(random));
+        }
+    }
+
+    double probabilities[ItemCount];
+    Probabilities(rarity, probabilities);
+    tables.emplace_back(rarity, AliasTable());
+    tables.back().second.Build(probabilities, ItemCount);
+    return static_cast<LootItem>(tables.back().second.Sample(random));
+}
@@ -5,9 +5,10 @@
 #include "enemy.h"
 #include "projectile.h"
 #include "entityLoader.h"
+#include "projectilePool.h"
 #include "constants.h"
 #include <vector>
-#include <GLFW/glfw3.h>
+#include "gameClock.h"
 #include <algorithm>
 
 Player::Player(Shape* shape, glm::vec3 position,Shader* projectileShader)
@@ -104,7 +105,7 @@ void Player::update(float deltaTime)
         proj->update(deltaTime);
         ++it;
     } else {
-        proj->markForDeletion(); 
+        ProjectilePool::Release(proj);
         it = activeProjectiles.erase(it); 
     }
 }
@@ -118,15 +119,7 @@ void Player::update(float deltaTime)
     updateAnimation(deltaTime);
 
     // items
-	for (auto it = temporaryItems.begin(); it != temporaryItems.end(); ) {
-        it->second -= deltaTime;
-        if (it->second <= 0.0f) {
-            // std::cout << "Temporary item expired: " << it->first << std::endl;
-            it = temporaryItems.erase(it);
-        } else {
-            ++it;
-        }
-    }
+    effects.Update(deltaTime);
 }
 
 void Player::draw(glm::mat4& view, glm::mat4& projection){
@@ -162,7 +155,7 @@ void Player::jump(){
 }
 
 void Player::shoot(glm::vec3 shootDirection) {
-    lastShootTime = glfwGetTime();
+    lastShootTime = GameClock::Now();
     recoilForce = 1.0f;
 
     if (attackCooldown <= 0.0f) {
@@ -183,20 +176,23 @@ void Player::shoot(glm::vec3 shootDirection) {
                            + (worldUp * upOffset) 
                            + (aimFlat * forwardOffset);
 
-		bool isLaser = std::find(items.begin(), items.end(), "Laser") != items.end();
-		bool isPierce = std::find(items.begin(), items.end(), "Pierce") != items.end();
-		bool isBounce = std::find(items.begin(), items.end(), "Bounce") != items.end();
+		bool isLaser = effects.Has(StatusEffect::Laser);
+		bool isPierce = effects.Has(StatusEffect::Pierce);
+		bool isBounce = effects.Has(StatusEffect::Bounce);
        
         if (isLaser) {
 
         }
         else {
-            Projectile* proj = EntityLoader::CreateProjectile(spawnPos, shootDirection, this);
-            if (isPierce) {
-                proj->setPierce(3);
-				// std::cout << "Projectile pierce set to 3." << std::endl;
-			}
-            activeProjectiles.push_back(proj);
+            // every pooled projectile in flight: the shot is dropped
+            Projectile* proj = ProjectilePool::Acquire();
+            if (proj) {
+                EntityLoader::LaunchProjectile(proj, spawnPos, shootDirection, this);
+                if (isPierce) {
+                    proj->setPierce(3);
+                }
+                activeProjectiles.push_back(proj);
+            }
         }
 
         attackCooldown = 1.0f / attackSpeed;
@@ -210,7 +206,7 @@ void Player::move(glm::vec3 direction)
 	if (isJumping) {
         localSpeed *= 0.8f; // Reduce speed while in air
     }
-	if (temporaryItems.find("SpeedBoost") != temporaryItems.end()) {
+	if (effects.Has(StatusEffect::SpeedBoost)) {
         localSpeed *= 2.0f; // Increase speed if SpeedBoost item is active
     }
     glm::vec3 normDir = glm::normalize(direction);
@@ -318,7 +314,7 @@ void Player::updateAnimation(float deltaTime) {
     float rawSpeed = glm::length(flatVel);
     bool isMoving = rawSpeed > 0.1f;
     bool isInAir = isJumping || std::abs(Velocity.y) > 0.5f;
-    float currentTime = (float)glfwGetTime();
+    float currentTime = static_cast<float>(GameClock::Now());
 
     // Stable reference for strafing
     if (!isMoving) movementReferenceForward = currentFront;
@@ -531,35 +527,14 @@ Node* recursiveFind(Node* node, std::string name) {
     return nullptr;
 }
 
-void Player::deleteActiveProjectile(Projectile* proj){
-    auto it = std::find(activeProjectiles.begin(), activeProjectiles.end(), proj);
-    if (it != activeProjectiles.end()) {
-        activeProjectiles.erase(it);
-    }
-	proj->markForDeletion();
-}
-
 void Player::AddPickup(Pickup* pickup, float lifetime){
-	if (pickup == nullptr || pickup->name == "PLACEHOLDER") return;
-	if (lifetime >= 0.0f) {
-        temporaryItems.insert({pickup->name, lifetime});
-    }
-    else {
-        items.push_back(pickup->name);
-    }
+	if (pickup == nullptr) return;
+	effects.Add(pickup->effect, lifetime);
 }
 
 void Player::RemovePickup(Pickup* pickup){
-    if (pickup == nullptr || pickup->name == "PLACEHOLDER") return;
-    auto it = std::find(items.begin(), items.end(), pickup->name);
-    if (it != items.end()) {
-        items.erase(it);
-    }
-
-    auto tempIt = temporaryItems.find(pickup->name);
-    if (tempIt != temporaryItems.end()) {
-		temporaryItems.erase(tempIt);
-    }
+    if (pickup == nullptr) return;
+    effects.Remove(pickup->effect);
 }
 void Player::resetPlayerState(glm::vec3 startPosition) {
     // Reset position and movement
@@ -585,10 +560,11 @@ void Player::resetPlayerState(glm::vec3 startPosition) {
     health = maxHealth;
     isDead = false;
     deathTimer = 0.0f;
+    effects.Clear();
 
     // Clear projectiles
     for (auto proj : activeProjectiles) {
-        PhysicObject::deleteObject(proj);
+        ProjectilePool::Release(proj);
     }
     activeProjectiles.clear();
 
@@ -17,6 +17,23 @@ Projectile::Projectile(Shape* shape, glm::vec3 position, float speed, float dama
     kinematic = false; // Projectiles are affected by physics
     }
 
+void Projectile::Launch(glm::vec3 position, glm::vec3 velocity, float damage, float range)
+{
+    Position = position;
+    Velocity = velocity;
+    Acceleration = glm::vec3(0.0f);
+    forcesApplied = glm::vec3(0.0f);
+    projectileSpeed = glm::length(velocity);
+    this->damage = damage;
+    this->range = range;
+    traveledDistance = 0.0f;
+    pierce = 0;
+    piercedEnemies.clear(); // keeps its capacity
+    piercedGhosts.clear();
+    active = true;
+    enabled = true;
+}
+
 void Projectile::update(float deltaTime)
 {
     if (!active){
@@ -52,10 +69,6 @@ void Projectile::reducePierce(int amount) {
 int Projectile::getPierce() {
     return pierce;
 }
-std::vector<Enemy*> Projectile::getPiercedEnemies() {
-    return piercedEnemies;
-}
-
 void Projectile::addPiercedEnemy(Enemy* enemy) {
 	if (!enemy) return;
 	if (std::find(piercedEnemies.begin(), piercedEnemies.end(), enemy) != piercedEnemies.end()) {
@@ -64,3 +77,11 @@ void Projectile::addPiercedEnemy(Enemy* enemy) {
     piercedEnemies.push_back(enemy);
 }
 
+bool Projectile::hasPiercedGhost(uint32_t id) const {
+    return std::find(piercedGhosts.begin(), piercedGhosts.end(), id) != piercedGhosts.end();
+}
+
+void Projectile::addPiercedGhost(uint32_t id) {
+    if (hasPiercedGhost(id)) return;
+    piercedGhosts.push_back(id);
+}
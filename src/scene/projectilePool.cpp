@@ -0,0 +1,32 @@
+#include "projectilePool.h"
+#include "projectile.h"
+#include "entityLoader.h"
+
+// initialize static variables
+std::vector<Projectile*> ProjectilePool::all;
+std::vector<Projectile*> ProjectilePool::freeList;
+
+void ProjectilePool::Init(size_t capacity) {
+    if (!all.empty()) return;
+
+    all.reserve(capacity);
+    freeList.reserve(capacity);
+    for (size_t i = 0; i < capacity; i++) {
+        Projectile* projectile = EntityLoader::CreateProjectile();
+        all.push_back(projectile);
+        freeList.push_back(projectile);
+    }
+}
+
+Projectile* ProjectilePool::Acquire() {
+    if (freeList.empty()) return nullptr;
+    Projectile* projectile = freeList.back();
+    freeList.pop_back();
+    return projectile;
+}
+
+void ProjectilePool::Release(Projectile* projectile) {
+    projectile->deactivate();
+    projectile->enabled = false;
+    freeList.push_back(projectile);
+}
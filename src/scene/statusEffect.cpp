@@ -0,0 +1,69 @@
+#include "statusEffect.h"
+#include <iostream>
+
+// same order as the enum
+static const char* const EFFECT_NAMES[StatusEffects::EffectCount] = {
+    "DamageBoost", "SpeedBoost", "Fear", "Laser", "Pierce", "Bounce",
+};
+
+const char* StatusEffectName(StatusEffect effect) {
+    if (effect >= StatusEffect::Count) return "";
+    return EFFECT_NAMES[static_cast<size_t>(effect)];
+}
+
+StatusEffect StatusEffectFromName(std::string_view name) {
+    for (size_t i = 0; i < StatusEffects::EffectCount; i++) {
+        if (name == EFFECT_NAMES[i]) return static_cast<StatusEffect>(i);
+    }
+    std::cerr << "[status effect] unknown effect \"" << name << "\"" << std::endl;
+    return StatusEffect::None;
+}
+
+void StatusEffects::Add(StatusEffect effect, float lifetime) {
+    if (effect >= StatusEffect::Count) return;
+    size_t index = static_cast<size_t>(effect);
+
+    if (lifetime < 0.0f) {
+        // a permanent item wins over a running timer
+        timed &= ~bit(effect);
+        timers[index] = 0.0f;
+    } else if (!Has(effect) || (timed & bit(effect))) {
+        timers[index] = Has(effect) && timers[index] > lifetime ? timers[index] : lifetime;
+        timed |= bit(effect);
+    }
+    active |= bit(effect);
+}
+
+void StatusEffects::Remove(StatusEffect effect) {
+    if (effect >= StatusEffect::Count) return;
+    active &= ~bit(effect);
+    timed &= ~bit(effect);
+    timers[static_cast<size_t>(effect)] = 0.0f;
+}
+
+void StatusEffects::Clear() {
+    active = 0;
+    timed = 0;
+    for (float& timer : timers) timer = 0.0f;
+}
+
+float StatusEffects::Remaining(StatusEffect effect) const {
+    if (effect >= StatusEffect::Count || !(timed & bit(effect))) return 0.0f;
+    return timers[static_cast<size_t>(effect)];
+}
+
+void StatusEffects::Update(float deltaTime) {
+    uint32_t pending = timed;
+    while (pending) {
+        uint32_t index = 0;
+        while (!(pending & (1u << index))) index++;
+        pending &= pending - 1; // clear the lowest set bit
+
+        timers[index] -= deltaTime;
+        if (timers[index] <= 0.0f) {
+            timers[index] = 0.0f;
+            active &= ~(1u << index);
+            timed &= ~(1u << index);
+        }
+    }
+}
@@ -1,4 +1,5 @@
 #include "shader.h"
+#include "frameUniforms.h"
 #include <iostream>
 #include <fstream>
 #include <cstring>
@@ -7,6 +8,24 @@
 
 using namespace std;
 
+// names of the Uniform enum entries, same order
+static const char* uniformNames[] = {
+    "model",
+    "view",
+    "projection",
+    "normalMatrix",
+    "objectColor",
+    "alpha",
+    "useCheckerboard",
+    "isEmissive",
+    "shadowMap",
+    "numActiveLights",
+    "lightPos",
+    "lightColors",
+    "lightIntensities"
+};
+static_assert(sizeof(uniformNames) / sizeof(uniformNames[0]) == static_cast<size_t>(Uniform::Count), "uniformNames out of sync with Uniform");
+
 Shader::Shader(const std::string& vertex_path, const std::string& fragment_path) {
     GLuint vert_shader, frag_shader;
     GLint status;
@@ -35,6 +54,17 @@ Shader::Shader(const std::string& vertex_path, const std::string& fragment_path)
     // Delete shaders
     glDeleteShader(vert_shader);
     glDeleteShader(frag_shader);
+
+    // resolve the per-draw uniforms once
+    for (int i = 0; i < static_cast<int>(Uniform::Count); i++) {
+        locations[i] = glGetUniformLocation(glid, uniformNames[i]);
+    }
+
+    // per-frame data comes from the shared uniform buffer
+    GLuint frameBlock = glGetUniformBlockIndex(glid, "FrameData");
+    if (frameBlock != GL_INVALID_INDEX) {
+        glUniformBlockBinding(glid, frameBlock, FrameUniforms::BindingPoint);
+    }
 }
 
 Shader::~Shader() {
@@ -46,6 +76,15 @@ GLuint Shader::get_id() {
     return glid;
 }
 
+GLint Shader::location(const std::string& name) {
+    auto it = namedLocations.find(name);
+    if (it != namedLocations.end()) return it->second;
+
+    GLint loc = glGetUniformLocation(glid, name.c_str());
+    namedLocations[name] = loc;
+    return loc;
+}
+
 GLuint Shader::compile_shader(const std::string& path, GLenum shader_type) {
 
     string source;
@@ -0,0 +1,208 @@
+#include "assetLoader.h"
+#include "resourceManager.h"
+#include "textRenderer.h"
+#include "modelCache.h"
+#include "hitchDetector.h"
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <stb_image.h>
+
+// initialize static variables
+std::vector<std::thread>                AssetLoader::workers;
+std::deque<std::function<void()>>       AssetLoader::jobs;
+std::mutex                              AssetLoader::jobMutex;
+std::condition_variable                 AssetLoader::jobReady;
+bool                                    AssetLoader::stopping = false;
+std::deque<AssetLoader::Upload>         AssetLoader::uploads;
+std::mutex                              AssetLoader::uploadMutex;
+std::condition_variable                 AssetLoader::uploadReady;
+std::vector<AssetState>                 AssetLoader::states(1, AssetState::Unknown);
+std::map<std::string, AssetHandle>      AssetLoader::inFlight;
+
+void AssetLoader::Start(unsigned int workerCount) {
+    if (!workers.empty()) return;
+    if (workerCount == 0) {
+        unsigned int hardware = std::thread::hardware_concurrency();
+        workerCount = hardware > 1 ? hardware - 1 : 1;
+    }
+
+    stopping = false;
+    for (unsigned int i = 0; i < workerCount; i++) {
+        workers.emplace_back(workerLoop);
+    }
+}
+
+void AssetLoader::Shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(jobMutex);
+        stopping = true;
+        jobs.clear();
+    }
+    jobReady.notify_all();
+    for (std::thread& worker : workers) worker.join();
+    workers.clear();
+
+    {
+        std::lock_guard<std::mutex> lock(uploadMutex);
+        uploads.clear();
+    }
+
+    // nothing left can finish them, Wait returns false instead of blocking
+    for (auto& iter : inFlight) states[iter.second] = AssetState::Failed;
+    inFlight.clear();
+}
+
+void AssetLoader::workerLoop() {
+    while (true) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(jobMutex);
+            jobReady.wait(lock, [] { return stopping || !jobs.empty(); });
+            if (stopping) return;
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+        job();
+    }
+}
+
+AssetHandle AssetLoader::request(const std::string& name, std::function<std::function<bool()>()> decode) {
+    auto found = inFlight.find(name);
+    if (found != inFlight.end()) return found->second;
+
+    Start();
+
+    AssetHandle handle = static_cast<AssetHandle>(states.size());
+    states.push_back(AssetState::Loading);
+    inFlight[name] = handle;
+
+    // the decode step returns the GL step, or an empty function on failure
+    std::function<void()> job = [handle, name, decode] {
+        std::function<bool()> upload = decode();
+        if (!upload) upload = [] { return false; };
+        {
+            std::lock_guard<std::mutex> lock(uploadMutex);
+            uploads.push_back(Upload{ handle, name, std::move(upload) });
+        }
+        uploadReady.notify_all();
+    };
+
+    {
+        std::lock_guard<std::mutex> lock(jobMutex);
+        jobs.push_back(std::move(job));
+    }
+    jobReady.notify_one();
+    return handle;
+}
+
+AssetHandle AssetLoader::LoadModelAsync(std::string file, std::string name, Shader* shader, GeometryRetention retention) {
+    return request(name, [file, name, shader, retention]() -> std::function<bool()> {
+        std::shared_ptr<ModelData> data = std::make_shared<ModelData>();
+        if (!Model::LoadData(file, *data)) return nullptr;
+
+        return [data, name, shader, retention] {
+            ResourceManager::Models[name] = new Model(*data, shader, retention);
+            return ResourceManager::Models[name]->rootNode != nullptr;
+        };
+    });
+}
+
+AssetHandle AssetLoader::LoadTextureAsync(std::string file, std::string name) {
+    return request(name, [file, name]() -> std::function<bool()> {
+        // the flip flag is per thread here, stbi_set_flip_vertically_on_load is not thread safe
+        stbi_set_flip_vertically_on_load_thread(true);
+        int width, height, nrComponents;
+        unsigned char* pixels = stbi_load(file.c_str(), &width, &height, &nrComponents, 4);
+        if (!pixels) {
+            std::cout << "[loader] texture failed to load: " << file << std::endl;
+            return nullptr;
+        }
+
+        std::shared_ptr<unsigned char> image(pixels, stbi_image_free);
+        return [image, width, height, name] {
+            ResourceManager::Textures[name] = ResourceManager::CreateTexture(image.get(), width, height);
+            return true;
+        };
+    });
+}
+
+AssetHandle AssetLoader::LoadFontAsync(TextRenderer* renderer, std::string font, unsigned int fontSize) {
+    return request(font + "@" + std::to_string(fontSize), [renderer, font, fontSize]() -> std::function<bool()> {
+        std::shared_ptr<std::vector<GlyphBitmap>> glyphs = std::make_shared<std::vector<GlyphBitmap>>();
+        if (!TextRenderer::Rasterize(font, fontSize, *glyphs)) return nullptr;
+
+        return [renderer, glyphs] {
+            renderer->Upload(*glyphs);
+            return true;
+        };
+    });
+}
+
+AssetState AssetLoader::GetState(AssetHandle handle) {
+    return handle < states.size() ? states[handle] : AssetState::Unknown;
+}
+
+AssetHandle AssetLoader::Find(const std::string& name) {
+    auto found = inFlight.find(name);
+    return found != inFlight.end() ? found->second : 0;
+}
+
+void AssetLoader::finish(Upload& upload) {
+    bool ok = upload.run();
+    states[upload.handle] = ok ? AssetState::Ready : AssetState::Failed;
+    inFlight.erase(upload.name);
+    if (!ok) std::cout << "[loader] failed to load " << upload.name << std::endl;
+}
+
+int AssetLoader::ProcessUploads(double budgetMs) {
+    auto start = std::chrono::steady_clock::now();
+    int count = 0;
+
+    while (true) {
+        Upload upload;
+        {
+            std::lock_guard<std::mutex> lock(uploadMutex);
+            if (uploads.empty()) break;
+            upload = std::move(uploads.front());
+            uploads.pop_front();
+        }
+        finish(upload);
+        count++;
+
+        // a large model can overrun the budget, the rest waits for the next frame
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        if (elapsed.count() >= budgetMs) break;
+    }
+    return count;
+}
+
+bool AssetLoader::Wait(AssetHandle handle) {
+    // blocking on a request from gameplay is a hitch, budgeted uploads are not
+    std::string name = "asset " + std::to_string(handle);
+    for (auto& iter : inFlight) {
+        if (iter.second == handle) name = iter.first;
+    }
+    LoadScope scope("waiting for " + name);
+    while (GetState(handle) == AssetState::Loading) {
+        Upload upload;
+        {
+            std::unique_lock<std::mutex> lock(uploadMutex);
+            uploadReady.wait(lock, [] { return !uploads.empty(); });
+            upload = std::move(uploads.front());
+            uploads.pop_front();
+        }
+        finish(upload);
+    }
+    return GetState(handle) == AssetState::Ready;
+}
+
+void AssetLoader::WaitAll() {
+    while (!inFlight.empty()) {
+        Wait(inFlight.begin()->second);
+    }
+}
+
+size_t AssetLoader::PendingCount() {
+    return inFlight.size();
+}
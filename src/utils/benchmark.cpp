@@ -0,0 +1,175 @@
+#include "benchmark.h"
+#include "crowd.h"
+#include "horde.h"
+#include "aiLod.h"
+#include "lootTable.h"
+#include "enemyPool.h"
+#include "constants.h"
+#include "random.h"
+#include <glm/glm.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// enemies per square unit, about what the spawner reaches around the player
+static const float CROWD_DENSITY = 0.5f;
+
+// average milliseconds per frame of steering every enemy
+template <typename Step>
+static double timeFrames(int frames, Step step) {
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; frame++) step();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / frames;
+}
+
+int Benchmark::Crowd() {
+    const size_t counts[] = { 100, 1000, 10000 };
+    Random random(1234);
+    float checksum = 0.0f; // keeps the steering from being optimized away
+    bool agree = true;
+
+    std::printf("%10s %14s %14s %10s %12s\n", "enemies", "grid ms", "all pairs ms", "speedup", "max error");
+    for (size_t count : counts) {
+        float side = std::sqrt(static_cast<float>(count) / CROWD_DENSITY);
+        std::vector<glm::vec3> positions(count);
+        for (glm::vec3& p : positions) {
+            p = glm::vec3(random.NextFloat() * side, 0.0f, random.NextFloat() * side);
+        }
+
+        // the grid is rebuilt every frame, as in Game::Update
+        double gridMs = timeFrames(50, [&] {
+            ::Crowd::Build(positions.data(), positions.size());
+            for (size_t i = 0; i < count; i++) checksum += ::Crowd::Steering(i).x;
+        });
+
+        int pairFrames = count >= 10000 ? 2 : 20;
+        double pairMs = timeFrames(pairFrames, [&] {
+            for (size_t i = 0; i < count; i++) checksum += ::Crowd::SteeringBruteForce(i).x;
+        });
+
+        float maxError = 0.0f;
+        for (size_t i = 0; i < count; i++) {
+            maxError = glm::max(maxError, glm::length(::Crowd::Steering(i) - ::Crowd::SteeringBruteForce(i)));
+        }
+
+        // both keep the same nearest neighbours and sum them in the same order
+        agree = agree && maxError <= 1e-5f;
+
+        std::printf("%10zu %14.3f %14.3f %9.1fx %12.2e\n", count, gridMs, pairMs, pairMs / gridMs, maxError);
+    }
+    std::printf("checksum %f\n", checksum);
+    if (!agree) std::printf("grid and all pairs steering differ\n");
+    return agree ? 0 : 1;
+}
+
+int Benchmark::Horde() {
+    const size_t counts[] = { 100, 1000, 10000 };
+    const int frames = 120;
+    const float deltaTime = 1.0f / 60.0f;
+    Random random(1234);
+
+    // CPU side only: no GL context, so the instanced draw itself is not timed,
+    // and no flow field, ghosts go straight at the target
+    std::printf("%10s %12s %14s %12s %14s\n", "ghosts", "update ms", "instances ms", "frame share", "plans/tick");
+    for (size_t count : counts) {
+        ::Horde::Clear();
+        for (size_t i = 0; i < count; i++) {
+            float angle = random.NextFloat() * 6.28318531f;
+            float distance = Config::Horde::SPAWN_MIN_RADIUS
+                           + random.NextFloat() * (Config::Horde::SPAWN_MAX_RADIUS - Config::Horde::SPAWN_MIN_RADIUS);
+            ::Horde::Spawn(1 + static_cast<int>(random.NextBelow(::Horde::TierCount)),
+                           glm::vec3(std::cos(angle) * distance, 0.0f, std::sin(angle) * distance));
+        }
+
+        // a fixed population, nothing spawns and nothing is shot
+        std::vector<Projectile*> noProjectiles;
+        double updateMs = timeFrames(frames, [&] {
+            AiLod::BeginFrame(Config::Game::fogEndDistance);
+            ::Horde::Update(deltaTime, glm::vec3(0.0f), false);
+            AiLod::EndFrame();
+            ::Horde::ApplyHits(noProjectiles);
+        });
+        double instanceMs = timeFrames(frames, [&] { ::Horde::BuildInstances(); });
+
+        std::printf("%10zu %12.3f %14.3f %11.1f%% %14d\n", ::Horde::Count(), updateMs, instanceMs,
+                    (updateMs + instanceMs) / (1000.0 / 60.0) * 100.0, AiLod::GetStats().thinks);
+    }
+    ::Horde::Clear();
+    return 0;
+}
+
+// weights of the string-keyed table drops were rolled from before the alias
+// tables, kept here as an independent reference
+static double legacyWeight(const char* name) {
+    static const struct { const char* name; double weight; } legacy[] = {
+        { "", 1.0 }, { "DamageBoost", 4.0 }, { "SpeedBoost", 2.0 }, { "HealthPack", 2.5 }, { "Fear", 5.5 },
+    };
+    for (const auto& entry : legacy) {
+        if (std::strcmp(entry.name, name) == 0) return entry.weight;
+    }
+    return -1.0;
+}
+
+// pearson statistic of observed counts against expected probabilities
+static double chiSquare(const size_t* observed, const double* expected, size_t count, size_t samples) {
+    double chi = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        double e = expected[i] * static_cast<double>(samples);
+        double d = static_cast<double>(observed[i]) - e;
+        chi += d * d / e;
+    }
+    return chi;
+}
+
+int Benchmark::Loot() {
+    const size_t samples = 1000000;
+    const size_t items = LootTable::ItemCount;
+    // 99.9th percentile of chi-square with items - 1 = 4 degrees of freedom
+    const double critical = 18.467;
+    Random random(1234);
+    int failures = 0;
+
+    std::printf("%6s %8s %12s %12s %12s %6s\n", "tier", "rarity", "chi2 table", "chi2 legacy", "max |dp|", "");
+    for (int tier = 1; tier <= EnemyPool::TierCount; tier++) {
+        // as Enemy::getRarityCoefficient
+        float rarity = 1.2f / static_cast<float>(tier);
+
+        double table[items];
+        LootTable::Probabilities(rarity, table);
+
+        // the formula drops were rolled with: exp(-alpha * weight), normalized
+        double legacy[items];
+        double total = 0.0;
+        for (size_t i = 0; i < items; i++) {
+            double weight = legacyWeight(LootTable::Info(static_cast<LootItem>(i)).name);
+            if (weight < 0.0) {
+                std::printf("item %zu (%s) missing from the legacy table\n", i, LootTable::Info(static_cast<LootItem>(i)).name);
+                return 1;
+            }
+            legacy[i] = std::exp(-1.0 * rarity * weight);
+            total += legacy[i];
+        }
+        double maxDelta = 0.0;
+        for (size_t i = 0; i < items; i++) {
+            legacy[i] /= total;
+            maxDelta = glm::max(maxDelta, std::fabs(legacy[i] - table[i]));
+        }
+
+        size_t observed[items] = { };
+        for (size_t n = 0; n < samples; n++) {
+            observed[static_cast<size_t>(LootTable::Sample(rarity, random))]++;
+        }
+
+        double chiTable = chiSquare(observed, table, items, samples);
+        double chiLegacy = chiSquare(observed, legacy, items, samples);
+        bool pass = chiTable < critical && chiLegacy < critical && maxDelta < 1e-9;
+        if (!pass) failures++;
+
+        std::printf("%6d %8.3f %12.3f %12.3f %12.2e %6s\n", tier, rarity, chiTable, chiLegacy, maxDelta, pass ? "ok" : "FAIL");
+    }
+    std::printf("%zu draws per tier, critical value %.3f\n", samples, critical);
+    return failures == 0 ? 0 : 1;
+}
@@ -6,6 +6,19 @@
 #include "projectile.h"
 #include "player.h"
 #include "constants.h"
+#include "assetLoader.h"
+
+// loaded model, finishing an in-flight async request rather than importing twice
+static Model* RequireModel(const std::string& file, const std::string& name, Shader* shader) {
+    Model* model = ResourceManager::GetModel(name);
+    if (model != nullptr) return model;
+
+    AssetHandle handle = AssetLoader::Find(name);
+    if (handle != 0 && AssetLoader::Wait(handle)) {
+        return ResourceManager::GetModel(name);
+    }
+    return ResourceManager::LoadModel(file, name, shader);
+}
 
 Player* EntityLoader::CreatePlayer(glm::vec3 position){
     Shader* StandardShader = ResourceManager::GetShader("standard");
@@ -22,10 +35,7 @@ Player* EntityLoader::CreatePlayer(glm::vec3 position){
 	player->collisionMask = CG_PRESETS_PLAYER;
     player->name = "Player";
 
-    Model* knight = ResourceManager::GetModel("knight");
-    if(knight == nullptr){
-        knight = ResourceManager::LoadModel( imageDir + "knight.glb", "knight", StandardShader);
-    }
+    Model* knight = RequireModel(imageDir + "knight.glb", "knight", StandardShader);
 
     if (knight->rootNode) {
         Node* playerModelNode = knight->rootNode->clone();
@@ -39,35 +49,45 @@ Player* EntityLoader::CreatePlayer(glm::vec3 position){
     return player;
 }
 
-Projectile* EntityLoader::CreateProjectile(glm::vec3 pos, glm::vec3 dir, Player* shooter){
+Projectile* EntityLoader::CreateProjectile(){
     Shader* StandardShader = ResourceManager::GetShader("standard");
-    glm::vec3 shootDirection = glm::normalize(dir);
-
-    Shape* proj_shape = new Sphere(StandardShader, shooter->getSize() * 0.2f, 20);
 
+    // radius, color and damage are set when the projectile is launched
+    Sphere* proj_shape = new Sphere(StandardShader, Config::Player::SIZE * 0.2f, Config::Projectile::SPHERE_SLICES);
     proj_shape->color = glm::vec3(1.0f, 0.96f, 0.86f);
     proj_shape->isEmissive = true;
 
-	float dmg = shooter->getAttackDamage();
-	if (shooter->temporaryItems.find("DamageBoost") != shooter->temporaryItems.end()) {
-		dmg *= 2.0f;
-        proj_shape->color = glm::vec3(1.0f,0.0f,0.0f);
-    }
-    Projectile* proj = new Projectile(proj_shape, pos, shooter->getProjectileSpeed(), dmg, 40.0f);
-    proj->Velocity = shootDirection * shooter->getProjectileSpeed();
+    Projectile* proj = new Projectile(proj_shape, glm::vec3(0.0f), Config::Player::PROJECTILE_SPEED, Config::Player::ATTACK_DAMAGE, 40.0f);
     proj->SetMass(0.2f);
     proj->kinematic = false;
     proj->collisionShape = proj_shape;
-    proj->collisionGroup = CollisionGroup::CG_PLAYER_PROJECTILE;
     proj->collisionGroup = CG_PLAYER_PROJECTILE;
 	proj->collisionMask = CG_ENEMY | CG_ENVIRONMENT | CG_PROP;
     proj->Restitution = 0.5f;
+    proj->instanced = true;
+    proj->deactivate();
+    proj->enabled = false;
+
+    return proj;
+}
+
+void EntityLoader::LaunchProjectile(Projectile* proj, glm::vec3 pos, glm::vec3 dir, Player* shooter){
+    glm::vec3 shootDirection = glm::normalize(dir);
+
+    Sphere* proj_shape = static_cast<Sphere*>(proj->shape);
+    proj_shape->radius = shooter->getSize() * 0.2f;
+    proj_shape->color = glm::vec3(1.0f, 0.96f, 0.86f);
+
+	float dmg = shooter->getAttackDamage();
+	if (shooter->effects.Has(StatusEffect::DamageBoost)) {
+		dmg *= 2.0f;
+        proj_shape->color = glm::vec3(1.0f,0.0f,0.0f);
+    }
+    proj->Launch(pos, shootDirection * shooter->getProjectileSpeed(), dmg, 40.0f);
 
     proj->setFrontVector(shootDirection);
     proj->setRightVector(glm::normalize(glm::cross(proj->GetFrontVector(), glm::vec3(0.0f, 1.0f, 0.0f))));
     proj->setUpVector(glm::normalize(glm::cross(proj->GetRightVector(), proj->GetFrontVector())));
-
-    return proj;
 }
 
 Enemy* EntityLoader::CreateEnemy(glm::vec3 position,int tier){
@@ -96,14 +116,10 @@ Enemy* EntityLoader::CreateEnemy(glm::vec3 position,int tier){
         enemy->setAttackSpeed(1.0f);
         enemy->setPower(10);
         enemy->setTier(1);
-        enemy->setHealth(20);
+        enemy->setMaxHealth(20);
         enemy->setExperienceReward(10.0f);
 
-        Model* ghostT1 = ResourceManager::GetModel("ghostT1");
-
-        if(ghostT1 == nullptr){
-            ghostT1 = ResourceManager::LoadModel( imageDir + "Mob_T1.glb", "ghostT1", StandardShader);
-        }
+        Model* ghostT1 = RequireModel(imageDir + "Mob_T1.glb", "ghostT1", StandardShader);
 
         if (ghostT1->rootNode) {
             Node* ghostT1ModelNode = ghostT1->rootNode->clone();
@@ -122,13 +138,10 @@ Enemy* EntityLoader::CreateEnemy(glm::vec3 position,int tier){
         enemy->setAttackSpeed(1.5f);
         enemy->setPower(20);
         enemy->setTier(2);
-        enemy->setHealth(45);
+        enemy->setMaxHealth(45);
         enemy->setExperienceReward(25.0f);
 
-        Model* ghostT2 = ResourceManager::GetModel("ghostT2");
-        if(ghostT2 == nullptr){
-            ghostT2 = ResourceManager::LoadModel( imageDir + "Mob_T2.glb", "ghostT2", StandardShader);
-        }
+        Model* ghostT2 = RequireModel(imageDir + "Mob_T2.glb", "ghostT2", StandardShader);
         if (ghostT2->rootNode) {
             Node* ghostT2ModelNode = ghostT2->rootNode->clone();
 
@@ -146,13 +159,10 @@ Enemy* EntityLoader::CreateEnemy(glm::vec3 position,int tier){
         enemy->setAttackSpeed(2.0f);
         enemy->setPower(30);
         enemy->setTier(3);
-        enemy->setHealth(120);
+        enemy->setMaxHealth(120);
         enemy->setExperienceReward(75.0f);
 
-        Model* ghostT3 = ResourceManager::GetModel("ghostT3");
-        if(ghostT3 == nullptr){
-            ghostT3 = ResourceManager::LoadModel( imageDir + "Mob_T3.glb", "ghostT3", StandardShader);
-        }
+        Model* ghostT3 = RequireModel(imageDir + "Mob_T3.glb", "ghostT3", StandardShader);
         if (ghostT3->rootNode) {
             Node* ghostT3ModelNode = ghostT3->rootNode->clone();
 
@@ -170,13 +180,10 @@ Enemy* EntityLoader::CreateEnemy(glm::vec3 position,int tier){
         enemy->setAttackSpeed(2.5f);
         enemy->setPower(40);
         enemy->setTier(4);
-        enemy->setHealth(400);
+        enemy->setMaxHealth(400);
         enemy->setExperienceReward(300.0f);
 
-        Model* ghostT4 = ResourceManager::GetModel("ghostT4");
-        if(ghostT4 == nullptr){
-            ghostT4 = ResourceManager::LoadModel( imageDir + "Mob_T4.glb", "ghostT4", StandardShader);
-        }
+        Model* ghostT4 = RequireModel(imageDir + "Mob_T4.glb", "ghostT4", StandardShader);
         if (ghostT4->rootNode) {
             Node* ghostT4ModelNode = ghostT4->rootNode->clone();
 
@@ -215,8 +222,8 @@ PhysicShapeObject* EntityLoader::CreateTestBox(glm::vec3 position){
     return testBox;
 }
 
-EnemySpawner* EntityLoader::CreateEnemySpawner(Node* sceneRoot, glm::vec3 position, std::vector<Enemy*>& enemyList){
-    EnemySpawner* spawner = new EnemySpawner(sceneRoot, position, enemyList);
+EnemySpawner* EntityLoader::CreateEnemySpawner(Node* sceneRoot, glm::vec3 position, std::vector<Enemy*>& enemyList, uint64_t seed){
+    EnemySpawner* spawner = new EnemySpawner(sceneRoot, position, enemyList, seed);
     spawner->name = "EnemySpawner";
     spawner->collisionGroup = CG_NONE;
     spawner->collisionMask = CG_NONE;
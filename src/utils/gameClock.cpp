@@ -0,0 +1,30 @@
+#include "gameClock.h"
+
+// initialize static variables
+float GameClock::fixedStep = 0.0f;
+double GameClock::now = 0.0;
+float GameClock::deltaTime = 0.0f;
+std::chrono::steady_clock::time_point GameClock::lastWall = std::chrono::steady_clock::now();
+
+void GameClock::SetFixedStep(float step) {
+    fixedStep = step > 0.0f ? step : 0.0f;
+}
+
+float GameClock::Tick() {
+    if (IsVirtual()) return Advance(fixedStep);
+
+    std::chrono::steady_clock::time_point wall = std::chrono::steady_clock::now();
+    std::chrono::duration<float> elapsed = wall - lastWall;
+    lastWall = wall;
+    deltaTime = elapsed.count();
+    now += deltaTime;
+    return deltaTime;
+}
+
+float GameClock::Advance(float step) {
+    // the wall clock resumes from here, e.g. when a replay hands over to live play
+    lastWall = std::chrono::steady_clock::now();
+    deltaTime = step;
+    now += step;
+    return deltaTime;
+}
@@ -0,0 +1,125 @@
+#include "headless.h"
+#include "gameClock.h"
+#include "hitchDetector.h"
+#include "inputLog.h"
+#include "inputScript.h"
+#include "constants.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+static double elapsedMs(std::chrono::steady_clock::time_point start) {
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+int Headless::Run(GameMode mode, unsigned long frames, float step, const std::string& scriptPath, uint64_t seed) {
+    if (step <= 0.0f) {
+        std::fprintf(stderr, "[headless] the step must be positive\n");
+        return 1;
+    }
+    InputScript script;
+    if (!script.Load(scriptPath)) return 1;
+
+    GameClock::SetFixedStep(step);
+    Viewer viewer(Config::SCR_WIDTH, Config::SCR_HEIGHT, true);
+    Game game(&viewer, mode, seed);
+
+    return simulate(viewer, game, frames, true, [&](unsigned long frame) {
+        script.Apply(frame, viewer);
+        if (viewer.keymap[GLFW_KEY_ESCAPE]) return false;
+        viewer.deltaTime = GameClock::Tick();
+        return true;
+    });
+}
+
+int Headless::Replay(const std::string& logPath) {
+    InputLog log;
+    if (!log.Load(logPath)) return 1;
+
+    Viewer viewer(Config::SCR_WIDTH, Config::SCR_HEIGHT, true);
+    Game game(&viewer, log.Mode(), log.Seed());
+
+    return simulate(viewer, game, log.FrameCount(), false, [&](unsigned long) {
+        viewer.deltaTime = log.Tick(viewer);
+        return true;
+    });
+}
+
+int Headless::simulate(Viewer& viewer, Game& game, unsigned long frames, bool restartRuns,
+                       const std::function<bool(unsigned long)>& tick) {
+    auto loadStart = std::chrono::steady_clock::now();
+    game.Init();
+    std::printf("[headless] loaded in %.0f ms, %lu frames\n", elapsedMs(loadStart), frames);
+
+    // update times of the current report, the percentile needs them all
+    std::vector<double> window;
+    window.reserve(Config::Headless::REPORT_FRAMES);
+    double totalMs = 0.0;
+    double worstMs = 0.0;
+    double worstP99 = 0.0;
+    int deaths = 0;
+    int wins = 0;
+    bool runOver = false;
+
+    auto report = [&](unsigned long frameCount) {
+        double sum = 0.0;
+        for (double ms : window) sum += ms;
+        size_t rank = window.size() * 99 / 100;
+        std::nth_element(window.begin(), window.begin() + rank, window.end());
+        double p99 = window[rank];
+        double max = *std::max_element(window.begin(), window.end());
+        worstP99 = std::max(worstP99, p99);
+
+        std::printf("%10lu %10.0f %10.3f %10.3f %10.3f %10zu %8d\n", frameCount, GameClock::Now(),
+                    sum / window.size(), p99, max, game.getEnemyCount(), game.getEnemyKilled());
+        window.clear();
+    };
+
+    std::printf("%10s %10s %10s %10s %10s %10s %8s\n", "frame", "sim s", "avg ms", "p99 ms", "max ms", "enemies", "kills");
+    auto runStart = std::chrono::steady_clock::now();
+    unsigned long frame = 0;
+    for (; frame < frames; frame++) {
+        if (!tick(frame)) break;
+
+        auto start = std::chrono::steady_clock::now();
+        game.Update();
+        double ms = elapsedMs(start);
+        HitchDetector::EndFrame(ms);
+
+        window.push_back(ms);
+        totalMs += ms;
+        worstMs = std::max(worstMs, ms);
+
+        bool over = !game.getPlayer()->isAlive() || game.getHasWon();
+        if (over && !runOver) {
+            if (game.getHasWon()) wins++;
+            else deaths++;
+        }
+        // a soak keeps playing and restarts as with the R key, a replay
+        // waits on the game over screen for the recorded R
+        if (over) {
+            if (restartRuns) game.ResetRun();
+            else game.ProcessGameOverInput();
+        }
+        runOver = !game.getPlayer()->isAlive() || game.getHasWon();
+
+        if (window.size() == Config::Headless::REPORT_FRAMES) report(frame + 1);
+    }
+    if (!window.empty()) report(frame);
+
+    double wallSeconds = elapsedMs(runStart) / 1000.0;
+    double simSeconds = GameClock::Now();
+    std::printf("[headless] %lu frames, %.0f s simulated in %.1f s (%.1fx real time)\n",
+                frame, simSeconds, wallSeconds, wallSeconds > 0.0 ? simSeconds / wallSeconds : 0.0);
+    std::printf("[headless] update avg %.3f ms, worst p99 %.3f ms, max %.3f ms\n",
+                frame > 0 ? totalMs / frame : 0.0, worstP99, worstMs);
+    std::printf("[headless] runs ended: %d deaths, %d wins, %u hitches\n", deaths, wins, HitchDetector::HitchCount());
+
+    // identical for two replays of the same recording
+    glm::vec3 position = game.getPlayer()->Position;
+    std::printf("[headless] final state: %d kills, %zu enemies, player at %.4f %.4f %.4f\n",
+                game.getEnemyKilled(), game.getEnemyCount(), position.x, position.y, position.z);
+    return 0;
+}
@@ -0,0 +1,42 @@
+#include "hitchDetector.h"
+#include <iostream>
+
+// initialize static variables
+bool                            HitchDetector::hotPath = false;
+unsigned long                   HitchDetector::frameIndex = 0;
+unsigned int                    HitchDetector::hitchCount = 0;
+std::vector<HitchDetector::Load> HitchDetector::frameLoads;
+int                             LoadScope::depth = 0;
+
+void HitchDetector::SetHotPath(bool hotPath) {
+    HitchDetector::hotPath = hotPath;
+    frameLoads.clear();
+}
+
+void HitchDetector::NoteLoad(const std::string& what, double ms) {
+    if (hotPath) frameLoads.push_back(Load{ what, ms });
+}
+
+void HitchDetector::EndFrame(double frameMs) {
+    frameIndex++;
+    if (frameLoads.empty()) return;
+
+    hitchCount++;
+    std::cout << "[hitch] frame " << frameIndex << " took " << frameMs << " ms, loaded on the hot path:";
+    for (const Load& load : frameLoads) {
+        std::cout << " " << load.what << " (" << load.ms << " ms)";
+    }
+    std::cout << std::endl;
+    frameLoads.clear();
+}
+
+LoadScope::LoadScope(std::string what) : what(std::move(what)), start(std::chrono::steady_clock::now()) {
+    depth++;
+}
+
+LoadScope::~LoadScope() {
+    depth--;
+    if (depth > 0) return;
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    HitchDetector::NoteLoad(what, elapsed.count());
+}
@@ -1,6 +1,7 @@
 #include "crosshair.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <glad/glad.h>
+#include "renderQueue.h"
 
 Crosshair::Crosshair(float size) : size(size) {
     std::string shader_dir = SHADER_DIR;
@@ -53,8 +54,7 @@ void Crosshair::draw(unsigned int textureID, float aspectRatio) {
     // set texture uniform
     glUniform1i(glGetUniformLocation(id, "crosshairTexture"), 0);
     // bind texture
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, textureID);
+    RenderQueue::BindTexture(GL_TEXTURE0, GL_TEXTURE_2D, textureID);
 
 
     // 4. Draw
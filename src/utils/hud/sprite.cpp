@@ -1,5 +1,6 @@
 #include "sprite.h"
 #include <glad/glad.h>
+#include "renderQueue.h"
 
 Sprite::Sprite(Shader* shader) : shader(shader) {
     this->initRenderData();
@@ -21,11 +22,10 @@ void Sprite::draw(unsigned int textureID, glm::vec2 position, glm::vec2 size, fl
     // Scale to size
     model = glm::scale(model, glm::vec3(size, 1.0f)); 
 
-    glUniformMatrix4fv(glGetUniformLocation(this->shader->get_id(), "model"), 1, GL_FALSE, &model[0][0]);
-    glUniform3f(glGetUniformLocation(this->shader->get_id(), "color"), color.x, color.y, color.z);
+    glUniformMatrix4fv(this->shader->location(Uniform::Model), 1, GL_FALSE, &model[0][0]);
+    glUniform3f(this->shader->location("color"), color.x, color.y, color.z);
 
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, textureID);
+    RenderQueue::BindTexture(GL_TEXTURE0, GL_TEXTURE_2D, textureID);
 
     glBindVertexArray(this->quadVAO);
     glDrawArrays(GL_TRIANGLES, 0, 6);
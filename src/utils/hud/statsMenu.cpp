@@ -1,5 +1,6 @@
 #include "statsMenu.h"
 #include "constants.h"
+#include "renderQueue.h"
 
 StatsMenu::StatsMenu(TextRenderer* textRenderer,Player* player)
 {
@@ -35,4 +36,15 @@ void StatsMenu::renderMenu()
     y-= 30.0f;
     std::string jumpStrengthText = "Jump Strength: " + std::to_string(static_cast<int>(player->getJumpStrength() * 5.0f));
     textRenderer->RenderText(jumpStrengthText, x, y, scale, color);
+
+    // GL state changes of the last complete frame
+    const RenderStats& stats = RenderQueue::GetLastFrameStats();
+    y -= 60.0f;
+    std::string drawsText = "Draws: " + std::to_string(stats.drawCalls) + "  Materials: " + std::to_string(stats.materialChanges);
+    textRenderer->RenderText(drawsText, x, y, scale, color);
+
+    y -= 30.0f;
+    std::string bindsText = "Binds: " + std::to_string(stats.programBinds) + " programs, " + std::to_string(stats.vaoBinds)
+                          + " VAOs, " + std::to_string(stats.textureBinds) + " textures";
+    textRenderer->RenderText(bindsText, x, y, scale, color);
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 # include <ft2build.h>
 # include FT_FREETYPE_H
 # include <iostream>
+# include <cstring>
+# include "renderQueue.h"
 
 TextRenderer::TextRenderer(unsigned int width, unsigned int height){
     // configure shader
@@ -24,25 +26,36 @@ TextRenderer::TextRenderer(unsigned int width, unsigned int height){
 
 void TextRenderer::Load(std::string font, unsigned int fontSize)
 {
-    // first clear the previously loaded Characters
-    Characters.clear();
-    // then initialize and load the FreeType library
+    std::vector<GlyphBitmap> glyphs;
+    Rasterize(font, fontSize, glyphs);
+    Upload(glyphs);
+}
+
+bool TextRenderer::Rasterize(std::string font, unsigned int fontSize, std::vector<GlyphBitmap>& glyphs)
+{
+    glyphs.clear();
+    // then initialize and load the FreeType library, one instance per call so
+    // several fonts can be rasterized on different threads
     FT_Library ft;
     if (FT_Init_FreeType(&ft)) // all functions return a value different than 0 whenever an error occurred
+    {
         std::cout << "ERROR::FREETYPE: Could not init FreeType Library" << std::endl;
+        return false;
+    }
 
     // load font as face
     FT_Face face;
     if (FT_New_Face(ft, font.c_str(), 0, &face))
+    {
         std::cout << "ERROR::FREETYPE: Failed to load font" << std::endl;
+        FT_Done_FreeType(ft);
+        return false;
+    }
 
     // set size to load glyphs as
     FT_Set_Pixel_Sizes(face, 0, fontSize);
 
-    // disable byte-alignment restriction
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1); 
-
-    // then for the first 128 ASCII characters, pre-load/compile their characters and store them
+    // then for the first 128 ASCII characters, rasterize their glyphs
     for (unsigned char c = 0; c < 128; c++)
     {
         // load character glyph 
@@ -51,20 +64,52 @@ void TextRenderer::Load(std::string font, unsigned int fontSize)
             std::cout << "ERROR::FREETYPE: Failed to load Glyph" << std::endl;
             continue;
         }
+        const FT_Bitmap& bitmap = face->glyph->bitmap;
+        GlyphBitmap glyph;
+        glyph.Code = static_cast<char>(c);
+        glyph.Size = glm::ivec2(bitmap.width, bitmap.rows);
+        glyph.Bearing = glm::ivec2(face->glyph->bitmap_left, face->glyph->bitmap_top);
+        glyph.Advance = static_cast<unsigned int>(face->glyph->advance.x);
+        // copy row by row, the FreeType pitch may be wider than the glyph
+        glyph.Pixels.resize(static_cast<size_t>(bitmap.width) * bitmap.rows);
+        for (unsigned int row = 0; row < bitmap.rows; row++)
+        {
+            std::memcpy(glyph.Pixels.data() + static_cast<size_t>(row) * bitmap.width,
+                        bitmap.buffer + static_cast<ptrdiff_t>(row) * bitmap.pitch, bitmap.width);
+        }
+        glyphs.push_back(std::move(glyph));
+    }
+    // destroy FreeType once we're finished
+    FT_Done_Face(face);
+    FT_Done_FreeType(ft);
+    return true;
+}
+
+void TextRenderer::Upload(const std::vector<GlyphBitmap>& glyphs)
+{
+    // first clear the previously loaded Characters
+    for (auto& iter : Characters) RenderQueue::DeleteTexture(iter.second.TextureID);
+    Characters.clear();
+
+    // disable byte-alignment restriction
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1); 
+
+    for (const GlyphBitmap& glyph : glyphs)
+    {
         // generate texture
         unsigned int texture;
         glGenTextures(1, &texture);
-        glBindTexture(GL_TEXTURE_2D, texture);
+        RenderQueue::BindTexture(GL_TEXTURE0, GL_TEXTURE_2D, texture);
         glTexImage2D(
             GL_TEXTURE_2D,
             0,
             GL_RED,
-            face->glyph->bitmap.width,
-            face->glyph->bitmap.rows,
+            glyph.Size.x,
+            glyph.Size.y,
             0,
             GL_RED,
             GL_UNSIGNED_BYTE,
-            face->glyph->bitmap.buffer
+            glyph.Pixels.empty() ? nullptr : glyph.Pixels.data()
         );
         // set texture options
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -74,16 +119,13 @@ void TextRenderer::Load(std::string font, unsigned int fontSize)
         // now store character for later use
         Character character = {
             texture,
-            glm::ivec2(face->glyph->bitmap.width, face->glyph->bitmap.rows),
-            glm::ivec2(face->glyph->bitmap_left, face->glyph->bitmap_top),
-            static_cast<unsigned int>(face->glyph->advance.x)
+            glyph.Size,
+            glyph.Bearing,
+            glyph.Advance
         };
-        Characters.insert(std::pair<char, Character>(c, character));
+        Characters.insert(std::pair<char, Character>(glyph.Code, character));
     }
-    glBindTexture(GL_TEXTURE_2D, 0);
-    // destroy FreeType once we're finished
-    FT_Done_Face(face);
-    FT_Done_FreeType(ft);
+    RenderQueue::BindTexture(GL_TEXTURE0, GL_TEXTURE_2D, 0);
 }
 
 
@@ -92,8 +134,7 @@ void TextRenderer::RenderText(std::string text, float x, float y, float scale, g
     Shader& TextShader = *ResourceManager::GetShader("text");
     // activate corresponding render state	
     glUseProgram(TextShader.get_id());
-    glUniform3f(glGetUniformLocation(TextShader.get_id(), "textColor"), color.x, color.y, color.z);
-    glActiveTexture(GL_TEXTURE0);
+    glUniform3f(TextShader.location("textColor"), color.x, color.y, color.z);
     glEnable(GL_BLEND);
     glBindVertexArray(VAO);
 
@@ -119,7 +160,7 @@ void TextRenderer::RenderText(std::string text, float x, float y, float scale, g
             { xpos + w, ypos + h,   1.0f, 0.0f }
         };
         // render glyph texture over quad
-        glBindTexture(GL_TEXTURE_2D, ch.TextureID);
+        RenderQueue::BindTexture(GL_TEXTURE0, GL_TEXTURE_2D, ch.TextureID);
         // update content of VBO memory
         glBindBuffer(GL_ARRAY_BUFFER, VBO);
         glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices); 
@@ -130,6 +171,6 @@ void TextRenderer::RenderText(std::string text, float x, float y, float scale, g
         x += (ch.Advance >> 6) * scale; // bitshift by 6 to get value in pixels (2^6 = 64)
     }
     glBindVertexArray(0);
-    glBindTexture(GL_TEXTURE_2D, 0);
+    RenderQueue::BindTexture(GL_TEXTURE0, GL_TEXTURE_2D, 0);
     glDisable(GL_BLEND);
 }
\ No newline at end of file
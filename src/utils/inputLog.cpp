@@ -0,0 +1,124 @@
+#include "inputLog.h"
+#include "viewer.h"
+#include "game.h"
+#include "gameClock.h"
+#include <cstring>
+#include <iostream>
+#include <iterator>
+
+// bit order of the key mask, new keys go at the end
+static const int loggedKeys[] = {
+    GLFW_KEY_W, GLFW_KEY_A, GLFW_KEY_S, GLFW_KEY_D, GLFW_KEY_SPACE, GLFW_MOUSE_BUTTON_LEFT,
+    GLFW_KEY_V, GLFW_KEY_R, GLFW_KEY_F, GLFW_KEY_ESCAPE
+};
+static const size_t loggedKeyCount = sizeof(loggedKeys) / sizeof(loggedKeys[0]);
+static const uint16_t TURNED_BIT = 0x8000; // yaw and pitch follow the mask
+static_assert(loggedKeyCount < 15, "the key mask is full");
+
+static const char MAGIC[4] = { 'I', 'L', 'O', 'G' };
+static const uint32_t VERSION = 1;
+
+// fields are stored in host byte order, recordings are not meant to move
+// between machines of different endianness
+template <typename T>
+static void put(std::ofstream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+static bool get(const std::vector<char>& data, size_t& offset, T& value) {
+    if (offset + sizeof(T) > data.size()) return false;
+    std::memcpy(&value, data.data() + offset, sizeof(T));
+    offset += sizeof(T);
+    return true;
+}
+
+InputLog::~InputLog() {
+    if (file.is_open()) {
+        file.close();
+        std::cout << "[input log] recorded " << next << " frames" << std::endl;
+    }
+}
+
+bool InputLog::Record(const std::string& path, uint64_t seed, GameMode mode) {
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open input log for writing: " << path << std::endl;
+        return false;
+    }
+    this->seed = seed;
+    this->mode = static_cast<uint8_t>(mode);
+
+    file.write(MAGIC, sizeof(MAGIC));
+    put(file, VERSION);
+    put(file, seed);
+    put(file, this->mode);
+    return true;
+}
+
+bool InputLog::Load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        std::cerr << "Failed to open input log: " << path << std::endl;
+        return false;
+    }
+    std::vector<char> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    size_t offset = sizeof(MAGIC);
+    uint32_t version = 0;
+    if (data.size() < sizeof(MAGIC) || std::memcmp(data.data(), MAGIC, sizeof(MAGIC)) != 0
+        || !get(data, offset, version) || version != VERSION || !get(data, offset, seed) || !get(data, offset, mode)) {
+        std::cerr << path << ": not an input log (version " << VERSION << ")" << std::endl;
+        return false;
+    }
+
+    frames.clear();
+    next = 0;
+    Frame frame{ 0.0f, 0, 0.0f, 0.0f };
+    while (offset < data.size()) {
+        // a recording cut short by a crash loses its partial last frame only
+        if (!get(data, offset, frame.deltaTime) || !get(data, offset, frame.keys)) break;
+        if ((frame.keys & TURNED_BIT) && (!get(data, offset, frame.yaw) || !get(data, offset, frame.pitch))) break;
+        frames.push_back(frame);
+    }
+
+    std::cout << "[input log] " << frames.size() << " frames loaded from " << path << std::endl;
+    return true;
+}
+
+GameMode InputLog::Mode() const {
+    return static_cast<GameMode>(mode);
+}
+
+float InputLog::Tick(Viewer& viewer) {
+    if (IsRecording()) {
+        Frame frame{ GameClock::Tick(), 0, viewer.camera->Yaw, viewer.camera->Pitch };
+        for (size_t i = 0; i < loggedKeyCount; i++) {
+            if (viewer.keymap[loggedKeys[i]]) frame.keys |= static_cast<uint16_t>(1u << i);
+        }
+
+        bool turned = !hasOrientation || frame.yaw != lastYaw || frame.pitch != lastPitch;
+        if (turned) frame.keys |= TURNED_BIT;
+
+        put(file, frame.deltaTime);
+        put(file, frame.keys);
+        if (turned) {
+            put(file, frame.yaw);
+            put(file, frame.pitch);
+            lastYaw = frame.yaw;
+            lastPitch = frame.pitch;
+            hasOrientation = true;
+        }
+        next++;
+        return frame.deltaTime;
+    }
+
+    if (Finished()) return GameClock::Tick();
+
+    const Frame& frame = frames[next++];
+    for (size_t i = 0; i < loggedKeyCount; i++) {
+        viewer.keymap[loggedKeys[i]] = (frame.keys >> i) & 1u;
+    }
+    viewer.camera->SetOrientation(frame.yaw, frame.pitch);
+    return GameClock::Advance(frame.deltaTime);
+}
@@ -0,0 +1,114 @@
+#include "inputScript.h"
+#include "viewer.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+static const struct { const char* name; int key; } keyNames[] = {
+    { "W", GLFW_KEY_W },
+    { "A", GLFW_KEY_A },
+    { "S", GLFW_KEY_S },
+    { "D", GLFW_KEY_D },
+    { "SPACE", GLFW_KEY_SPACE },
+    { "FIRE", GLFW_MOUSE_BUTTON_LEFT },
+    { "V", GLFW_KEY_V },
+    { "R", GLFW_KEY_R },
+    { "F", GLFW_KEY_F },
+    { "ESCAPE", GLFW_KEY_ESCAPE }
+};
+
+static bool parseKey(const std::string& name, int& key) {
+    for (const auto& entry : keyNames) {
+        if (name == entry.name) {
+            key = entry.key;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool InputScript::Load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open input script: " << path << std::endl;
+        return false;
+    }
+
+    events.clear();
+    loopFrames = 0;
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+
+        // skip comments and empty lines
+        size_t start = line.find_first_not_of(" \t");
+        if (start == std::string::npos || line[start] == '#') continue;
+
+        std::istringstream stream(line);
+        std::string first;
+        stream >> first;
+
+        if (first == "loop") {
+            if (!(stream >> loopFrames)) {
+                std::cerr << path << ":" << lineNumber << ": expected 'loop <frames>'" << std::endl;
+                loopFrames = 0;
+            }
+            continue;
+        }
+
+        InputEvent event;
+        std::string type;
+        bool valid = false;
+        std::istringstream frameStream(first);
+        if (frameStream >> event.frame && stream >> type) {
+            std::string key;
+            if (type == "press" || type == "release") {
+                event.type = type == "press" ? InputEvent::Type::Press : InputEvent::Type::Release;
+                valid = static_cast<bool>(stream >> key) && parseKey(key, event.key);
+            } else if (type == "look") {
+                event.type = InputEvent::Type::Look;
+                valid = static_cast<bool>(stream >> event.dx >> event.dy);
+            }
+        }
+
+        if (!valid) {
+            std::cerr << path << ":" << lineNumber << ": expected '<frame> press|release <key>', "
+                      << "'<frame> look <dx> <dy>' or 'loop <frames>'" << std::endl;
+            continue;
+        }
+        events.push_back(event);
+    }
+
+    // file order is kept between events of the same frame
+    std::stable_sort(events.begin(), events.end(), [](const InputEvent& a, const InputEvent& b) {
+        return a.frame < b.frame;
+    });
+
+    std::cout << "[input] " << events.size() << " events loaded from " << path << std::endl;
+    return true;
+}
+
+void InputScript::Apply(unsigned long frame, Viewer& viewer) const {
+    if (loopFrames > 0) frame %= loopFrames;
+
+    auto first = std::lower_bound(events.begin(), events.end(), frame, [](const InputEvent& event, unsigned long f) {
+        return event.frame < f;
+    });
+    for (auto it = first; it != events.end() && it->frame == frame; ++it) {
+        switch (it->type) {
+            case InputEvent::Type::Press:
+                viewer.keymap[it->key] = true;
+                break;
+            case InputEvent::Type::Release:
+                viewer.keymap[it->key] = false;
+                break;
+            case InputEvent::Type::Look:
+                viewer.camera->ProcessMouseMovement(it->dx, it->dy);
+                break;
+        }
+    }
+}
@@ -0,0 +1,48 @@
+#include "material.h"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+// initialize static variables, entry 0 is the default gray
+std::vector<Material> MaterialTable::materials = { Material{ "default", glm::vec3(0.5f, 0.5f, 0.5f) } };
+
+bool MaterialTable::Load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open material table: " << path << std::endl;
+        return false;
+    }
+
+    materials.resize(1);
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+
+        // skip comments and empty lines
+        size_t start = line.find_first_not_of(" \t");
+        if (start == std::string::npos || line[start] == '#') continue;
+
+        std::istringstream stream(line);
+        Material material;
+        if (!(stream >> material.pattern >> material.color.x >> material.color.y >> material.color.z)) {
+            std::cerr << path << ":" << lineNumber << ": expected '<name> <r> <g> <b>'" << std::endl;
+            continue;
+        }
+        materials.push_back(material);
+    }
+
+    std::cout << "[materials] " << materials.size() - 1 << " entries loaded from " << path << std::endl;
+    return true;
+}
+
+MaterialID MaterialTable::Resolve(const std::string& materialName) {
+    for (size_t i = 1; i < materials.size(); i++) {
+        if (materialName.find(materials[i].pattern) != std::string::npos) {
+            return static_cast<MaterialID>(i);
+        }
+    }
+    return DefaultMaterial;
+}
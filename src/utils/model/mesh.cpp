@@ -1,146 +1,240 @@
 #include "mesh.h"
 #include <glm/gtc/type_ptr.hpp>
+#include <glm/gtc/packing.hpp>
+#include <cfloat>
+#include <cstdint>
+#include <cstring>
 
-Mesh::Mesh(std::vector<Vertex> vertices, std::vector<unsigned int> indices, std::vector<Texture> textures, Shader* shader, std::string matName) 
-    : Shape(shader) 
+// largest position error accepted from snorm16 quantization, in model units
+static const float MAX_QUANTIZATION_ERROR = 0.001f;
+
+MeshData::MeshData(std::vector<Vertex> vertices, std::vector<unsigned int> indices, std::vector<Texture> textures, std::string matName,
+                   MaterialID materialID, GeometryRetention retention) 
 {
-    this->vertices = vertices;
-    this->indices = indices;
-    this->textures = textures;
-    this->materialName = matName;
-    
-    setupMesh();
+    this->vertices = std::move(vertices);
+    this->indices = std::move(indices);
+    this->textures = std::move(textures);
+    this->materialName = std::move(matName);
+    this->materialID = materialID;
+
+    PackedGeometry packed;
+    std::vector<unsigned char> vertexBytes, indexBytes;
+    Pack(this->vertices.data(), this->vertices.size(), this->indices.data(), this->indices.size(), !this->textures.empty(),
+         packed, vertexBytes, indexBytes);
+    upload(packed);
+
+    if (retention == GeometryRetention::Release) {
+        std::vector<Vertex>().swap(this->vertices);
+        std::vector<unsigned int>().swap(this->indices);
+    }
+}
+
+MeshData::MeshData(const PackedGeometry& packed, const Vertex* vertices, const unsigned int* indices, std::string matName,
+                   MaterialID materialID, GeometryRetention retention)
+{
+    this->materialName = std::move(matName);
+    this->materialID = materialID;
+
+    if (retention == GeometryRetention::Keep) {
+        this->vertices.assign(vertices, vertices + packed.vertexCount);
+        this->indices.assign(indices, indices + packed.indexCount);
+    }
+
+    upload(packed);
+}
+
+MeshData::~MeshData() {
+    glDeleteVertexArrays(1, &VAO);
+    glDeleteBuffers(1, &VBO);
+    glDeleteBuffers(1, &EBO);
+}
+
+size_t MeshData::residentBytes() const {
+    return sizeof(MeshData)
+        + vertices.capacity() * sizeof(Vertex)
+        + indices.capacity() * sizeof(unsigned int)
+        + textures.capacity() * sizeof(Texture);
+}
+
+size_t MeshData::gpuBytes() const {
+    size_t indexSize = layout.indexType == GL_UNSIGNED_SHORT ? sizeof(uint16_t) : sizeof(uint32_t);
+    return static_cast<size_t>(vertexCount) * layout.stride + static_cast<size_t>(indexCount) * indexSize;
+}
+
+DrawGeometry MeshData::geometry() const {
+    DrawGeometry geometry{ VAO, static_cast<GLsizei>(indexCount), layout.indexType };
+    geometry.scale = glm::vec3(positionScale);
+    geometry.offset = positionOffset;
+    return geometry;
 }
 
-void Mesh::setupMesh() {
+void MeshData::Pack(const Vertex* vertexData, size_t vertexCount, const unsigned int* indexData, size_t indexCount, bool hasTexCoords,
+                    PackedGeometry& out, std::vector<unsigned char>& vertexStorage, std::vector<unsigned char>& indexStorage) {
+    out.vertexCount = static_cast<uint32_t>(vertexCount);
+    out.indexCount = static_cast<uint32_t>(indexCount);
+
+    // bounds survive the release of the CPU arrays
+    out.aabbMin = glm::vec3(FLT_MAX);
+    out.aabbMax = glm::vec3(-FLT_MAX);
+    for (size_t i = 0; i < vertexCount; i++) {
+        out.aabbMin = glm::min(out.aabbMin, vertexData[i].Position);
+        out.aabbMax = glm::max(out.aabbMax, vertexData[i].Position);
+    }
+
+    // quantize against a cube around the bounds: the decode transform is a
+    // translation and a uniform scale, so normals need no correction
+    glm::vec3 center = vertexCount > 0 ? (out.aabbMin + out.aabbMax) * 0.5f : glm::vec3(0.0f);
+    glm::vec3 halfExtent = vertexCount > 0 ? (out.aabbMax - out.aabbMin) * 0.5f : glm::vec3(0.0f);
+    float extent = glm::max(glm::max(halfExtent.x, halfExtent.y), glm::max(halfExtent.z, 1e-6f));
+
+    VertexLayout& layout = out.layout;
+    layout.quantizedPositions = extent / 32767.0f <= MAX_QUANTIZATION_ERROR;
+    layout.hasTexCoords = hasTexCoords;
+    layout.indexType = vertexCount <= 65536 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+
+    // position (8 or 12 bytes) + 10:10:10:2 normal + optional half UV
+    layout.stride = (layout.quantizedPositions ? 4 * sizeof(int16_t) : 3 * sizeof(float))
+                  + sizeof(uint32_t)
+                  + (layout.hasTexCoords ? sizeof(uint32_t) : 0);
+
+    out.positionOffset = layout.quantizedPositions ? center : glm::vec3(0.0f);
+    out.positionScale = layout.quantizedPositions ? extent : 1.0f;
+
+    // pack the vertices in the layout chosen for this mesh
+    vertexStorage.assign(vertexCount * layout.stride, 0);
+    for (size_t i = 0; i < vertexCount; i++) {
+        const Vertex& v = vertexData[i];
+        unsigned char* dst = vertexStorage.data() + i * layout.stride;
+
+        if (layout.quantizedPositions) {
+            glm::vec3 p = glm::clamp((v.Position - out.positionOffset) / out.positionScale, glm::vec3(-1.0f), glm::vec3(1.0f));
+            int16_t q[4] = {
+                static_cast<int16_t>(glm::round(p.x * 32767.0f)),
+                static_cast<int16_t>(glm::round(p.y * 32767.0f)),
+                static_cast<int16_t>(glm::round(p.z * 32767.0f)),
+                0
+            };
+            std::memcpy(dst, q, sizeof(q));
+            dst += sizeof(q);
+        } else {
+            std::memcpy(dst, &v.Position[0], 3 * sizeof(float));
+            dst += 3 * sizeof(float);
+        }
+
+        uint32_t normal = glm::packSnorm3x10_1x2(glm::vec4(v.Normal, 0.0f));
+        std::memcpy(dst, &normal, sizeof(normal));
+        dst += sizeof(normal);
+
+        if (layout.hasTexCoords) {
+            uint32_t uv = glm::packHalf2x16(v.TexCoords);
+            std::memcpy(dst, &uv, sizeof(uv));
+        }
+    }
+
+    if (layout.indexType == GL_UNSIGNED_SHORT) {
+        indexStorage.resize(indexCount * sizeof(uint16_t));
+        for (size_t i = 0; i < indexCount; i++) {
+            uint16_t index = static_cast<uint16_t>(indexData[i]);
+            std::memcpy(indexStorage.data() + i * sizeof(uint16_t), &index, sizeof(index));
+        }
+    } else {
+        indexStorage.resize(indexCount * sizeof(uint32_t));
+        if (indexCount > 0) std::memcpy(indexStorage.data(), indexData, indexCount * sizeof(uint32_t));
+    }
+
+    out.vertexBytes = vertexStorage.data();
+    out.indexBytes = indexStorage.data();
+}
+
+void MeshData::upload(const PackedGeometry& packed) {
+    vertexCount = packed.vertexCount;
+    indexCount = packed.indexCount;
+    aabbMin = packed.aabbMin;
+    aabbMax = packed.aabbMax;
+    layout = packed.layout;
+    positionOffset = packed.positionOffset;
+    positionScale = packed.positionScale;
+
+    size_t indexSize = layout.indexType == GL_UNSIGNED_SHORT ? sizeof(uint16_t) : sizeof(uint32_t);
+
     glGenVertexArrays(1, &VAO);
     glGenBuffers(1, &VBO);
     glGenBuffers(1, &EBO);
 
+    // both buffers go up straight from the packed bytes
     glBindVertexArray(VAO);
     glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), &vertices[0], GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<size_t>(vertexCount) * layout.stride, packed.vertexBytes, GL_STATIC_DRAW);
 
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), &indices[0], GL_STATIC_DRAW);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<size_t>(indexCount) * indexSize, packed.indexBytes, GL_STATIC_DRAW);
+
+    size_t offset = 0;
 
     // position
     glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
+    if (layout.quantizedPositions) {
+        glVertexAttribPointer(0, 3, GL_SHORT, GL_TRUE, layout.stride, (void*)offset);
+        offset += 4 * sizeof(int16_t);
+    } else {
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, layout.stride, (void*)offset);
+        offset += 3 * sizeof(float);
+    }
     
     // normal
     glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Normal));
+    glVertexAttribPointer(1, 4, GL_INT_2_10_10_10_REV, GL_TRUE, layout.stride, (void*)offset);
+    offset += sizeof(uint32_t);
     
     // texture coordinates
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, TexCoords));
-    
-    // tangent
-    glEnableVertexAttribArray(3);
-    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Tangent));
+    if (layout.hasTexCoords) {
+        glEnableVertexAttribArray(2);
+        glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, layout.stride, (void*)offset);
+    }
 
     glBindVertexArray(0);
 }
 
+Mesh::Mesh(std::shared_ptr<const MeshData> data, Shader* shader)
+    : Shape(shader), data(std::move(data))
+{
+}
+
+glm::vec3 Mesh::getColor() const {
+    return MaterialTable::Get(data->materialID).color;
+}
+
 void Mesh::draw(glm::mat4& model, glm::mat4& view, glm::mat4& projection) {
     glUseProgram(shader_program_);
 
-    unsigned int modelLoc = glGetUniformLocation(shader_program_, "model");
-    unsigned int viewLoc  = glGetUniformLocation(shader_program_, "view");
-    unsigned int projLoc  = glGetUniformLocation(shader_program_, "projection");
+    // decodes quantized positions, a translation and a uniform scale
+    glm::mat4 meshModel = data->geometry().localTransform(model);
+    glUniformMatrix4fv(shader_->location(Uniform::Model), 1, GL_FALSE, glm::value_ptr(meshModel));
 
-    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-    glUniformMatrix4fv(viewLoc, 1, GL_FALSE, glm::value_ptr(view));
-    glUniformMatrix4fv(projLoc, 1, GL_FALSE, glm::value_ptr(projection));
+    // programs reading the FrameData block get view/projection from the uniform buffer
+    GLint loc = shader_->location(Uniform::View);
+    if (loc != -1) glUniformMatrix4fv(loc, 1, GL_FALSE, glm::value_ptr(view));
+    loc = shader_->location(Uniform::Projection);
+    if (loc != -1) glUniformMatrix4fv(loc, 1, GL_FALSE, glm::value_ptr(projection));
 
-    // define material color based on materialName
-    glm::vec3 finalColor(0.5f, 0.5f, 0.5f); // gray
+    glm::vec3 finalColor = getColor();
 
-    // gold
-    if (materialName.find("Trim") != std::string::npos || materialName.find("Gold") != std::string::npos) {
-        finalColor = glm::vec3(1.0f, 0.84f, 0.0f); 
-    }
-    // gray 2
-    else if (materialName.find("Steel") != std::string::npos || materialName.find("Metal") != std::string::npos) {
-        finalColor = glm::vec3(0.60f, 0.65f, 0.70f); 
-    }
-    // black
-    else if (materialName.find("Dark") != std::string::npos || materialName.find("Leather") != std::string::npos) {
-        finalColor = glm::vec3(0.15f, 0.15f, 0.15f); 
-    }
-    // void
-    else if (materialName.find("VOID") != std::string::npos) {
-        finalColor = glm::vec3(0.1f, 0.0f, 0.2f); 
-    }
-    else if (materialName.find("SPECTRAL_T1") != std::string::npos) {
-        finalColor = glm::vec3(0.5f, 0.95f, 1.0f);
-    }
-    else if (materialName.find("SPECTRAL_T2") != std::string::npos) {
-        finalColor = glm::vec3(0.85f, 0.50f, 1.0f);
-    }
-    else if (materialName.find("SPECTRAL_T3") != std::string::npos) {
-        finalColor = glm::vec3(1.0f, 0.2f, 0.40f);
-    }
-    else if (materialName.find("SPECTRAL_T4") != std::string::npos) {
-        finalColor = glm::vec3 (0.0f, 0.0f, 0.0f);
-    }
-    else if (materialName.find("central") != std::string::npos) {
-        finalColor = glm::vec3 (0.253f, 0.261f, 0.274f);
-    }
-    else if (materialName.find("grass") != std::string::npos) {
-        finalColor = glm::vec3 (0.237f, 0.328f, 0.240f);
-    }
-    else if (materialName.find("graves") != std::string::npos) {
-        finalColor = glm::vec3 (0.281f, 0.236f, 0.213f);
-    }
-    else if (materialName.find("grille") != std::string::npos) {
-        finalColor = glm::vec3(0.070f, 0.070f, 0.070f);
-    }
-    else if (materialName.find("Image") != std::string::npos) {
-        finalColor = glm::vec3 (0.269f, 0.219f, 0.158f);
-    }
-    else if (materialName.find("mansion") != std::string::npos) {
-        finalColor = glm::vec3 (0.318f, 0.326f, 0.305f);
-    }
-    else if (materialName.find("mountains") != std::string::npos) {
-        finalColor = glm::vec3(0.338f, 0.312f, 0.319f);
-    }
-    else if (materialName.find("ocean") != std::string::npos) {
-        finalColor = glm::vec3(0.187f, 0.205f, 0.347f);
-    }
-    else if (materialName.find("pillar") != std::string::npos) {
-        finalColor = glm::vec3(0.269f, 0.219f, 0.158f);
-    }
-    else if (materialName.find("tombstone") != std::string::npos) {
-        finalColor = glm::vec3(0.231f, 0.132f, 0.121f);
-    }
-    else if (materialName.find("tree") != std::string::npos) {
-        finalColor = glm::vec3(0.243f, 0.165f, 0.129f);
-    }
-    else if (materialName.find("pillars_mini") != std::string::npos) {
-        finalColor = glm::vec3(0.101f, 0.101f, 0.101f);
-    }
-        
-    
-    glUniform3fv(glGetUniformLocation(shader_program_, "objectColor"), 1, glm::value_ptr(finalColor));
-    glUniform1i(glGetUniformLocation(shader_program_, "useCheckerboard"), 0);
-    glUniform1i(glGetUniformLocation(shader_program_, "isEmissive"), 0);
+    glUniform3fv(shader_->location(Uniform::ObjectColor), 1, glm::value_ptr(finalColor));
+    glUniform1i(shader_->location(Uniform::UseCheckerboard), 0);
+    glUniform1i(shader_->location(Uniform::IsEmissive), 0);
 
-    glUniform1f(glGetUniformLocation(shader_program_, "alpha"), alpha);
+    glUniform1f(shader_->location(Uniform::Alpha), alpha);
     
      glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(model)));
-     glUniformMatrix3fv(glGetUniformLocation(shader_program_, "normalMatrix"), 1, GL_FALSE, glm::value_ptr(normalMatrix));
+     glUniformMatrix3fv(shader_->location(Uniform::NormalMatrix), 1, GL_FALSE, glm::value_ptr(normalMatrix));
 
-    glBindVertexArray(VAO);
+    glBindVertexArray(data->VAO);
 
     if (alpha < 1.0f) {
         glDepthMask(GL_FALSE); 
-        glUniform1i(glGetUniformLocation(shader_program_, "isShadowPass"), false);
-
     }
 
-    glDrawElements(GL_TRIANGLES, static_cast<unsigned int>(indices.size()), GL_UNSIGNED_INT, 0);
+    glDrawElements(GL_TRIANGLES, data->indexCount, data->layout.indexType, 0);
 
     if (alpha < 1.0f) {
         glDepthMask(GL_TRUE); 
@@ -149,6 +243,11 @@ void Mesh::draw(glm::mat4& model, glm::mat4& view, glm::mat4& projection) {
     glBindVertexArray(0);
 }
 
+// only the shared geometry handle is copied, never the vertex data
 Shape* Mesh::clone() const {
     return new Mesh(*this);
+}
+
+DrawGeometry Mesh::getGeometry() const {
+    return data->geometry();
 }
\ No newline at end of file
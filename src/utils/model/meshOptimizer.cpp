@@ -0,0 +1,168 @@
+#include "meshOptimizer.h"
+#include <algorithm>
+#include <cmath>
+
+// Forsyth's scoring parameters, see "Linear-Speed Vertex Cache Optimisation"
+static const int   CACHE_SIZE = 32;
+static const float CACHE_DECAY_POWER = 1.5f;
+static const float LAST_TRI_SCORE = 0.75f;
+static const float VALENCE_BOOST_SCALE = 2.0f;
+static const float VALENCE_BOOST_POWER = 0.5f;
+
+static float vertexScore(int cachePosition, int remainingTriangles) {
+    // no triangle left to draw with this vertex
+    if (remainingTriangles == 0) return -1.0f;
+
+    float score = 0.0f;
+    if (cachePosition >= 0) {
+        if (cachePosition < 3) {
+            // used by the last triangle, fixed score so it isn't reused right away
+            score = LAST_TRI_SCORE;
+        } else {
+            float scaler = 1.0f / (CACHE_SIZE - 3);
+            score = std::pow(1.0f - (cachePosition - 3) * scaler, CACHE_DECAY_POWER);
+        }
+    }
+
+    // favour vertices with few triangles left, they free the cache sooner
+    score += VALENCE_BOOST_SCALE * std::pow(static_cast<float>(remainingTriangles), -VALENCE_BOOST_POWER);
+    return score;
+}
+
+void MeshOptimizer::OptimizeVertexCache(std::vector<unsigned int>& indices, size_t vertexCount) {
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0 || vertexCount == 0) return;
+
+    // triangles using each vertex, flattened
+    std::vector<int> remaining(vertexCount, 0);
+    for (unsigned int index : indices) remaining[index]++;
+
+    std::vector<size_t> adjacencyStart(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; v++) adjacencyStart[v + 1] = adjacencyStart[v] + remaining[v];
+
+    std::vector<size_t> adjacency(indices.size());
+    std::vector<size_t> fill(adjacencyStart.begin(), adjacencyStart.end() - 1);
+    for (size_t t = 0; t < triangleCount; t++) {
+        for (int k = 0; k < 3; k++) adjacency[fill[indices[t * 3 + k]]++] = t;
+    }
+
+    std::vector<int> cachePosition(vertexCount, -1);
+    std::vector<float> score(vertexCount);
+    for (size_t v = 0; v < vertexCount; v++) score[v] = vertexScore(-1, remaining[v]);
+
+    std::vector<bool> emitted(triangleCount, false);
+    std::vector<unsigned int> output;
+    output.reserve(indices.size());
+
+    // LRU cache, three extra slots hold what the newest triangle pushes out
+    std::vector<unsigned int> cache;
+    std::vector<unsigned int> newCache;
+    cache.reserve(CACHE_SIZE + 3);
+    newCache.reserve(CACHE_SIZE + 3);
+
+    size_t nextUnemitted = 0;
+    long best = 0;
+    while (output.size() < indices.size()) {
+        if (best < 0) {
+            // nothing in the cache is usable, restart from the first triangle left
+            while (emitted[nextUnemitted]) nextUnemitted++;
+            best = static_cast<long>(nextUnemitted);
+        }
+
+        size_t t = static_cast<size_t>(best);
+        emitted[t] = true;
+
+        // new cache order: the triangle's vertices first, then the previous entries
+        newCache.clear();
+        for (int k = 0; k < 3; k++) {
+            unsigned int v = indices[t * 3 + k];
+            output.push_back(v);
+            newCache.push_back(v);
+
+            // drop the triangle from the vertex's live list
+            remaining[v]--;
+            size_t begin = adjacencyStart[v];
+            size_t end = begin + remaining[v] + 1;
+            for (size_t i = begin; i < end; i++) {
+                if (adjacency[i] == t) {
+                    std::swap(adjacency[i], adjacency[end - 1]);
+                    break;
+                }
+            }
+        }
+        for (unsigned int v : cache) {
+            if (v != newCache[0] && v != newCache[1] && v != newCache[2]) newCache.push_back(v);
+        }
+
+        // vertices pushed out of the cache lose their position score
+        for (size_t i = CACHE_SIZE; i < newCache.size(); i++) {
+            cachePosition[newCache[i]] = -1;
+            score[newCache[i]] = vertexScore(-1, remaining[newCache[i]]);
+        }
+        if (newCache.size() > static_cast<size_t>(CACHE_SIZE)) {
+            newCache.resize(CACHE_SIZE);
+        }
+        std::swap(cache, newCache);
+
+        for (size_t i = 0; i < cache.size(); i++) {
+            unsigned int v = cache[i];
+            cachePosition[v] = static_cast<int>(i);
+            score[v] = vertexScore(static_cast<int>(i), remaining[v]);
+        }
+
+        // only triangles touching the cache changed, the best one is among them
+        best = -1;
+        float bestScore = -1.0f;
+        for (unsigned int v : cache) {
+            for (size_t j = adjacencyStart[v]; j < adjacencyStart[v] + remaining[v]; j++) {
+                size_t tri = adjacency[j];
+                float s = score[indices[tri * 3]] + score[indices[tri * 3 + 1]] + score[indices[tri * 3 + 2]];
+                if (s > bestScore) {
+                    bestScore = s;
+                    best = static_cast<long>(tri);
+                }
+            }
+        }
+    }
+
+    indices.swap(output);
+}
+
+void MeshOptimizer::OptimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices) {
+    const unsigned int unused = static_cast<unsigned int>(-1);
+    std::vector<unsigned int> remap(vertices.size(), unused);
+    std::vector<Vertex> reordered;
+    reordered.reserve(vertices.size());
+
+    // vertices in the order the index buffer first reads them
+    for (unsigned int& index : indices) {
+        if (remap[index] == unused) {
+            remap[index] = static_cast<unsigned int>(reordered.size());
+            reordered.push_back(vertices[index]);
+        }
+        index = remap[index];
+    }
+
+    // unreferenced vertices go last so bounds and counts are unchanged
+    for (size_t v = 0; v < vertices.size(); v++) {
+        if (remap[v] == unused) reordered.push_back(vertices[v]);
+    }
+
+    vertices.swap(reordered);
+}
+
+float MeshOptimizer::ComputeACMR(const std::vector<unsigned int>& indices, size_t vertexCount, unsigned int cacheSize) {
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0) return 0.0f;
+
+    // FIFO cache, timestamps tell whether a vertex is still inside
+    std::vector<size_t> insertedAt(vertexCount, 0);
+    size_t misses = 0;
+    for (unsigned int index : indices) {
+        if (insertedAt[index] == 0 || misses + 1 - insertedAt[index] > cacheSize) {
+            misses++;
+            insertedAt[index] = misses;
+        }
+    }
+    return static_cast<float>(misses) / static_cast<float>(triangleCount);
+}
@@ -1,11 +1,31 @@
 #include "model.h"
+#include "meshOptimizer.h"
 
 #include <assimp/Importer.hpp>
 #include <assimp/postprocess.h>
 #include <iostream>
 
-Model::Model(std::string const &path, Shader* shader) : shader(shader) {
-    loadModel(path);
+Model::Model(std::string const &path, Shader* shader, GeometryRetention retention)
+    : rootNode(nullptr), shader(shader), retention(retention) {
+    directory = path.substr(0, path.find_last_of('/'));
+
+    ModelData data;
+    if (LoadData(path, data)) {
+        rootNode = buildNodes(data);
+    }
+}
+
+Model::Model(const ModelData& data, Shader* shader, GeometryRetention retention)
+    : rootNode(nullptr), shader(shader), retention(retention) {
+    rootNode = buildNodes(data);
+}
+
+Model::Model(Shader* shader, std::string directory, GeometryRetention retention)
+    : rootNode(nullptr), shader(shader), directory(std::move(directory)), retention(retention) {
+}
+
+Model::~Model() {
+    delete rootNode;
 }
 
 void Model::Draw(glm::mat4& model, glm::mat4& view, glm::mat4& projection) {
@@ -13,48 +33,97 @@ void Model::Draw(glm::mat4& model, glm::mat4& view, glm::mat4& projection) {
         rootNode->draw(model, view, projection);
 }
 
-void Model::loadModel(std::string const &path) {
+bool Model::LoadData(std::string const &path, ModelData& data) {
+    // the binary cache skips assimp entirely, its arrays are uploaded from the mapped file
+    if (ModelCache::Load(path, data)) return true;
+    if (!importModel(path, data)) return false;
+
+    // a cache miss packs every mesh once, the cache then stores the packed bytes
+    data.packedStorage.resize(data.meshes.size() * 2);
+    for (size_t i = 0; i < data.meshes.size(); i++) {
+        MeshRecord& record = data.meshes[i];
+        MeshData::Pack(record.vertices, record.vertexCount, record.indices, record.indexCount, false,
+                       record.packed, data.packedStorage[2 * i], data.packedStorage[2 * i + 1]);
+    }
+    ModelCache::Write(path, data);
+    return true;
+}
+
+Node* Model::buildNodes(const ModelData& data) {
+    // each mesh is uploaded once, even when several nodes reference it
+    std::vector<std::shared_ptr<const MeshData>> meshes;
+    meshes.reserve(data.meshes.size());
+    for (const MeshRecord& record : data.meshes) {
+        // the color is looked up here once, never by name at draw time
+        MaterialID materialID = MaterialTable::Resolve(record.materialName);
+        meshes.push_back(std::make_shared<const MeshData>(record.packed, record.vertices, record.indices,
+                                                          record.materialName, materialID, retention));
+    }
+
+    // parents are stored before their children
+    std::vector<Node*> nodes;
+    nodes.reserve(data.nodes.size());
+    for (const NodeRecord& record : data.nodes) {
+        Node* newNode = new Node();
+        newNode->name = record.name;
+        newNode->set_transform(record.transform);
+
+        for (uint32_t mesh : record.meshes) {
+            newNode->add(new Mesh(meshes[mesh], shader));
+        }
+        if (record.parent >= 0) {
+            nodes[record.parent]->add(newNode);
+        }
+        nodes.push_back(newNode);
+    }
+
+    return nodes.empty() ? nullptr : nodes[0];
+}
+
+bool Model::importModel(std::string const &path, ModelData& data) {
     Assimp::Importer importer;
     const aiScene* scene = importer.ReadFile(path, aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_CalcTangentSpace);
 
     if(!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
         std::cout << "ERROR::ASSIMP:: " << importer.GetErrorString() << std::endl;
-        return;
+        return false;
     }
 
-    directory = path.substr(0, path.find_last_of('/'));
-    rootNode = processNode(scene->mRootNode, scene);
+    // assimp mesh index -> record, -1 until processed
+    std::vector<int32_t> meshRecords(scene->mNumMeshes, -1);
+    processNode(scene->mRootNode, scene, data, -1, meshRecords);
+    return true;
 }
 
-Node* Model::processNode(aiNode *node, const aiScene *scene) {
-    Node* newNode = new Node();
-    newNode->name = node->mName.C_Str();
+void Model::processNode(aiNode *node, const aiScene *scene, ModelData& data, int32_t parent, std::vector<int32_t>& meshRecords) {
+    NodeRecord record;
+    record.name = node->mName.C_Str();
+    record.parent = parent;
     
     // transform convert
-    glm::mat4 transform = aiMatrix4x4ToGlm(node->mTransformation);
-    newNode->set_transform(transform);
+    record.transform = aiMatrix4x4ToGlm(node->mTransformation);
 
     // meshes
     for(unsigned int i = 0; i < node->mNumMeshes; i++) {
-        aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
-        Mesh* myMesh = processMesh(mesh, scene);
-        newNode->add(myMesh);
+        unsigned int meshIndex = node->mMeshes[i];
+        if (meshRecords[meshIndex] < 0) {
+            meshRecords[meshIndex] = static_cast<int32_t>(processMesh(scene->mMeshes[meshIndex], scene, data));
+        }
+        record.meshes.push_back(static_cast<uint32_t>(meshRecords[meshIndex]));
     }
 
+    int32_t self = static_cast<int32_t>(data.nodes.size());
+    data.nodes.push_back(record);
+
     // child nodes
     for(unsigned int i = 0; i < node->mNumChildren; i++) {
-        Node* childNode = processNode(node->mChildren[i], scene);
-        newNode->add(childNode);
+        processNode(node->mChildren[i], scene, data, self, meshRecords);
     }
-
-    return newNode;
 }
 
-Mesh* Model::processMesh(aiMesh *mesh, const aiScene *scene) {
+uint32_t Model::processMesh(aiMesh *mesh, const aiScene *scene, ModelData& data) {
     std::vector<Vertex> vertices;
     std::vector<unsigned int> indices;
-    std::vector<Texture> textures;
-
     // handle vertices
     for(unsigned int i = 0; i < mesh->mNumVertices; i++) {
         Vertex vertex;
@@ -77,12 +146,23 @@ Mesh* Model::processMesh(aiMesh *mesh, const aiScene *scene) {
     }
 
     // handle indices
+    bool trianglesOnly = true;
     for(unsigned int i = 0; i < mesh->mNumFaces; i++) {
         aiFace face = mesh->mFaces[i];
+        trianglesOnly = trianglesOnly && face.mNumIndices == 3;
         for(unsigned int j = 0; j < face.mNumIndices; j++)
             indices.push_back(face.mIndices[j]);
     }
 
+    // reorder for the post-transform cache, then for fetch locality
+    if (trianglesOnly && !indices.empty()) {
+        float acmrBefore = MeshOptimizer::ComputeACMR(indices, vertices.size());
+        MeshOptimizer::OptimizeVertexCache(indices, vertices.size());
+        MeshOptimizer::OptimizeVertexFetch(vertices, indices);
+        float acmrAfter = MeshOptimizer::ComputeACMR(indices, vertices.size());
+        std::cout << "[vcache] " << mesh->mName.C_Str() << ": ACMR " << acmrBefore << " -> " << acmrAfter << std::endl;
+    }
+
     // gather textures and add them to the textures vector if needed
     std::string matName = "default";
     if (mesh->mMaterialIndex >= 0) {
@@ -93,7 +173,19 @@ Mesh* Model::processMesh(aiMesh *mesh, const aiScene *scene) {
         }
     }
 
-    return new Mesh(vertices, indices, textures, shader, matName);
+    // arrays are owned by data, records point into them
+    data.vertexStorage.push_back(std::move(vertices));
+    data.indexStorage.push_back(std::move(indices));
+
+    MeshRecord record;
+    record.name = mesh->mName.C_Str();
+    record.materialName = matName;
+    record.vertices = data.vertexStorage.back().data();
+    record.vertexCount = static_cast<uint32_t>(data.vertexStorage.back().size());
+    record.indices = data.indexStorage.back().data();
+    record.indexCount = static_cast<uint32_t>(data.indexStorage.back().size());
+    data.meshes.push_back(record);
+    return static_cast<uint32_t>(data.meshes.size() - 1);
 }
 
 glm::mat4 Model::aiMatrix4x4ToGlm(const aiMatrix4x4& from) {
@@ -107,14 +199,35 @@ glm::mat4 Model::aiMatrix4x4ToGlm(const aiMatrix4x4& from) {
 }
 
 Model* Model::clone(Shader* shader) {
-    Model* newModel = new Model(*this);
-    newModel->shader = shader;
-
+    // deep copy, each model deletes its own tree
+    Model* newModel = new Model(shader, directory, retention);
     if (this->rootNode) {
         newModel->rootNode = this->rootNode->clone();
-    } else {
-        newModel->rootNode = nullptr;
     }
-
     return newModel;
+}
+
+// visit every mesh of a node hierarchy
+static void accumulateGeometryBytes(const Node* node, size_t& resident, size_t& gpu) {
+    for (Shape* shape : node->getShapes()) {
+        Mesh* mesh = dynamic_cast<Mesh*>(shape);
+        if (!mesh) continue;
+        resident += mesh->data->residentBytes();
+        gpu += mesh->data->gpuBytes();
+    }
+    for (const Node* child : node->getChildren()) {
+        accumulateGeometryBytes(child, resident, gpu);
+    }
+}
+
+size_t Model::residentGeometryBytes() const {
+    size_t resident = 0, gpu = 0;
+    if (rootNode) accumulateGeometryBytes(rootNode, resident, gpu);
+    return resident;
+}
+
+size_t Model::gpuGeometryBytes() const {
+    size_t resident = 0, gpu = 0;
+    if (rootNode) accumulateGeometryBytes(rootNode, resident, gpu);
+    return gpu;
 }
\ No newline at end of file
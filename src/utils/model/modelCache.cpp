@@ -0,0 +1,340 @@
+#include "modelCache.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+static const char CACHE_MAGIC[8] = { 'M', 'D', 'L', 'C', 'A', 'C', 'H', 'E' };
+
+struct CacheHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t vertexSize; // sizeof(Vertex) of the writer
+    uint64_t sourceSize;
+    int64_t sourceTime;
+    uint32_t meshCount;
+    uint32_t nodeCount;
+};
+
+// layout of a packed mesh, its vertex and index bytes follow
+struct PackedHeader {
+    uint32_t quantizedPositions;
+    uint32_t hasTexCoords;
+    uint32_t indexType;
+    uint32_t stride;
+    float positionOffset[3];
+    float positionScale;
+    float aabbMin[3];
+    float aabbMax[3];
+};
+
+// ---- MappedFile ----
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const std::string& path) {
+    close();
+#ifndef _WIN32
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+
+    void* address = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) return false;
+
+    bytes = static_cast<const unsigned char*>(address);
+    length = static_cast<size_t>(info.st_size);
+    mapped = true;
+    return true;
+#else
+    // no mmap here, read the whole file instead
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) return false;
+    std::streamsize size = file.tellg();
+    if (size <= 0) return false;
+    fallback.resize(static_cast<size_t>(size));
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char*>(fallback.data()), size)) return false;
+
+    bytes = fallback.data();
+    length = fallback.size();
+    return true;
+#endif
+}
+
+void MappedFile::close() {
+#ifndef _WIN32
+    if (mapped && bytes) munmap(const_cast<unsigned char*>(bytes), length);
+#endif
+    bytes = nullptr;
+    length = 0;
+    mapped = false;
+    std::vector<unsigned char>().swap(fallback);
+}
+
+// ---- reading ----
+
+// bounds-checked cursor over the mapped bytes, every record is 4-byte aligned
+class CacheReader {
+public:
+    CacheReader(const unsigned char* data, size_t size) : data(data), size(size), offset(0), ok(true) { }
+
+    const void* take(size_t bytes) {
+        if (!ok || bytes > size - offset) {
+            ok = false;
+            return nullptr;
+        }
+        const void* p = data + offset;
+        offset += (bytes + 3) & ~static_cast<size_t>(3);
+        if (offset > size) offset = size;
+        return p;
+    }
+
+    uint32_t u32() {
+        const void* p = take(sizeof(uint32_t));
+        uint32_t value = 0;
+        if (p) std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    std::string str() {
+        uint32_t length = u32();
+        const char* p = static_cast<const char*>(take(length));
+        return p ? std::string(p, length) : std::string();
+    }
+
+    bool good() const { return ok; }
+
+private:
+    const unsigned char* data;
+    size_t size;
+    size_t offset;
+    bool ok;
+};
+
+bool ModelCache::SourceStamp(const std::string& sourcePath, uint64_t& size, int64_t& time) {
+    std::error_code error;
+    uintmax_t fileSize = fs::file_size(sourcePath, error);
+    if (error) return false;
+    fs::file_time_type writeTime = fs::last_write_time(sourcePath, error);
+    if (error) return false;
+
+    size = static_cast<uint64_t>(fileSize);
+    time = static_cast<int64_t>(writeTime.time_since_epoch().count());
+    return true;
+}
+
+std::string ModelCache::CachePathFor(const std::string& sourcePath) {
+    // file name plus a hash of the full path, two sources may share a name
+    std::string name = fs::path(sourcePath).filename().string();
+    size_t pathHash = std::hash<std::string>()(sourcePath);
+    return std::string(CACHE_DIR) + name + "." + std::to_string(pathHash) + ".mdlcache";
+}
+
+bool ModelCache::Load(const std::string& sourcePath, ModelData& out) {
+    uint64_t sourceSize;
+    int64_t sourceTime;
+    if (!SourceStamp(sourcePath, sourceSize, sourceTime)) return false;
+
+    std::string cachePath = CachePathFor(sourcePath);
+    if (!out.mapping.open(cachePath)) return false;
+
+    // leave out empty so the caller can import from scratch
+    auto reject = [&out](const char* reason, const std::string& path) {
+        std::cout << "[model cache] " << reason << ": " << path << std::endl;
+        out.nodes.clear();
+        out.meshes.clear();
+        out.mapping.close();
+        return false;
+    };
+
+    CacheReader reader(out.mapping.data(), out.mapping.size());
+    const CacheHeader* headerPtr = static_cast<const CacheHeader*>(reader.take(sizeof(CacheHeader)));
+    if (!headerPtr) return reject("malformed", cachePath);
+    CacheHeader header;
+    std::memcpy(&header, headerPtr, sizeof(header));
+
+    if (std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 || header.version != Version ||
+        header.vertexSize != sizeof(Vertex) || header.sourceSize != sourceSize || header.sourceTime != sourceTime) {
+        return reject("stale", cachePath);
+    }
+    if (header.meshCount > out.mapping.size() || header.nodeCount > out.mapping.size()) {
+        return reject("malformed", cachePath);
+    }
+
+    // meshes point straight into the mapped file
+    out.meshes.resize(header.meshCount);
+    for (MeshRecord& mesh : out.meshes) {
+        mesh.name = reader.str();
+        mesh.materialName = reader.str();
+        mesh.vertexCount = reader.u32();
+        mesh.indexCount = reader.u32();
+        mesh.vertices = static_cast<const Vertex*>(reader.take(static_cast<size_t>(mesh.vertexCount) * sizeof(Vertex)));
+        mesh.indices = static_cast<const unsigned int*>(reader.take(static_cast<size_t>(mesh.indexCount) * sizeof(unsigned int)));
+
+        const void* packedPtr = reader.take(sizeof(PackedHeader));
+        if (!packedPtr) return reject("malformed", cachePath);
+        PackedHeader packed;
+        std::memcpy(&packed, packedPtr, sizeof(packed));
+
+        // the packed bytes are uploaded as they are, so the layout must be one MeshData::Pack could produce
+        VertexLayout& layout = mesh.packed.layout;
+        layout.quantizedPositions = packed.quantizedPositions != 0;
+        layout.hasTexCoords = packed.hasTexCoords != 0;
+        layout.indexType = packed.indexType;
+        layout.stride = static_cast<GLsizei>(packed.stride);
+        GLsizei expectedStride = (layout.quantizedPositions ? 4 * sizeof(int16_t) : 3 * sizeof(float))
+                               + sizeof(uint32_t) + (layout.hasTexCoords ? sizeof(uint32_t) : 0);
+        if (layout.stride != expectedStride || (layout.indexType != GL_UNSIGNED_SHORT && layout.indexType != GL_UNSIGNED_INT)) {
+            return reject("malformed", cachePath);
+        }
+        size_t indexSize = layout.indexType == GL_UNSIGNED_SHORT ? sizeof(uint16_t) : sizeof(uint32_t);
+
+        mesh.packed.positionOffset = glm::vec3(packed.positionOffset[0], packed.positionOffset[1], packed.positionOffset[2]);
+        mesh.packed.positionScale = packed.positionScale;
+        mesh.packed.aabbMin = glm::vec3(packed.aabbMin[0], packed.aabbMin[1], packed.aabbMin[2]);
+        mesh.packed.aabbMax = glm::vec3(packed.aabbMax[0], packed.aabbMax[1], packed.aabbMax[2]);
+        mesh.packed.vertexCount = mesh.vertexCount;
+        mesh.packed.indexCount = mesh.indexCount;
+        mesh.packed.vertexBytes = static_cast<const unsigned char*>(reader.take(static_cast<size_t>(mesh.vertexCount) * layout.stride));
+        mesh.packed.indexBytes = static_cast<const unsigned char*>(reader.take(static_cast<size_t>(mesh.indexCount) * indexSize));
+    }
+
+    out.nodes.resize(header.nodeCount);
+    for (size_t i = 0; i < out.nodes.size(); i++) {
+        NodeRecord& node = out.nodes[i];
+        node.name = reader.str();
+        node.parent = static_cast<int32_t>(reader.u32());
+        const void* transform = reader.take(sizeof(glm::mat4));
+        if (transform) std::memcpy(&node.transform, transform, sizeof(glm::mat4));
+        uint32_t meshCount = reader.u32();
+        for (uint32_t m = 0; m < meshCount && reader.good(); m++) {
+            node.meshes.push_back(reader.u32());
+        }
+
+        // reject references a loader would follow out of bounds
+        bool validParent = (i == 0) ? node.parent == -1 : (node.parent >= 0 && static_cast<size_t>(node.parent) < i);
+        if (!reader.good() || !validParent) return reject("malformed", cachePath);
+        for (uint32_t mesh : node.meshes) {
+            if (mesh >= out.meshes.size()) return reject("malformed", cachePath);
+        }
+    }
+
+    if (!reader.good() || out.nodes.empty()) return reject("malformed", cachePath);
+    return true;
+}
+
+// ---- writing ----
+
+static void writePadding(std::ofstream& file, size_t written) {
+    static const char zeros[4] = { 0, 0, 0, 0 };
+    size_t padding = ((written + 3) & ~static_cast<size_t>(3)) - written;
+    if (padding) file.write(zeros, padding);
+}
+
+static void writeU32(std::ofstream& file, uint32_t value) {
+    file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+static void writeString(std::ofstream& file, const std::string& value) {
+    writeU32(file, static_cast<uint32_t>(value.size()));
+    file.write(value.data(), value.size());
+    writePadding(file, value.size());
+}
+
+bool ModelCache::Write(const std::string& sourcePath, const ModelData& data) {
+    CacheHeader header;
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = Version;
+    header.vertexSize = sizeof(Vertex);
+    if (!SourceStamp(sourcePath, header.sourceSize, header.sourceTime)) return false;
+    header.meshCount = static_cast<uint32_t>(data.meshes.size());
+    header.nodeCount = static_cast<uint32_t>(data.nodes.size());
+
+    std::error_code error;
+    fs::create_directories(CACHE_DIR, error);
+
+    // write next to the target then rename, a crash never leaves half a cache
+    std::string cachePath = CachePathFor(sourcePath);
+    std::string tempPath = cachePath + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "[model cache] can't write " << tempPath << std::endl;
+            return false;
+        }
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        writePadding(file, sizeof(header));
+
+        for (const MeshRecord& mesh : data.meshes) {
+            writeString(file, mesh.name);
+            writeString(file, mesh.materialName);
+            writeU32(file, mesh.vertexCount);
+            writeU32(file, mesh.indexCount);
+            file.write(reinterpret_cast<const char*>(mesh.vertices), static_cast<std::streamsize>(mesh.vertexCount) * sizeof(Vertex));
+            file.write(reinterpret_cast<const char*>(mesh.indices), static_cast<std::streamsize>(mesh.indexCount) * sizeof(unsigned int));
+
+            const PackedGeometry& geometry = mesh.packed;
+            PackedHeader packed;
+            packed.quantizedPositions = geometry.layout.quantizedPositions ? 1 : 0;
+            packed.hasTexCoords = geometry.layout.hasTexCoords ? 1 : 0;
+            packed.indexType = geometry.layout.indexType;
+            packed.stride = static_cast<uint32_t>(geometry.layout.stride);
+            for (int c = 0; c < 3; c++) {
+                packed.positionOffset[c] = geometry.positionOffset[c];
+                packed.aabbMin[c] = geometry.aabbMin[c];
+                packed.aabbMax[c] = geometry.aabbMax[c];
+            }
+            packed.positionScale = geometry.positionScale;
+            file.write(reinterpret_cast<const char*>(&packed), sizeof(packed));
+
+            size_t indexSize = geometry.layout.indexType == GL_UNSIGNED_SHORT ? sizeof(uint16_t) : sizeof(uint32_t);
+            size_t vertexBytes = static_cast<size_t>(geometry.vertexCount) * geometry.layout.stride;
+            size_t indexBytes = static_cast<size_t>(geometry.indexCount) * indexSize;
+            file.write(reinterpret_cast<const char*>(geometry.vertexBytes), static_cast<std::streamsize>(vertexBytes));
+            writePadding(file, vertexBytes);
+            file.write(reinterpret_cast<const char*>(geometry.indexBytes), static_cast<std::streamsize>(indexBytes));
+            writePadding(file, indexBytes);
+        }
+
+        for (const NodeRecord& node : data.nodes) {
+            writeString(file, node.name);
+            writeU32(file, static_cast<uint32_t>(node.parent));
+            file.write(reinterpret_cast<const char*>(&node.transform), sizeof(glm::mat4));
+            writeU32(file, static_cast<uint32_t>(node.meshes.size()));
+            for (uint32_t mesh : node.meshes) writeU32(file, mesh);
+        }
+
+        if (!file.good()) {
+            std::cerr << "[model cache] write failed: " << tempPath << std::endl;
+            return false;
+        }
+    }
+
+    fs::rename(tempPath, cachePath, error);
+    if (error) {
+        fs::remove(tempPath, error);
+        return false;
+    }
+    std::cout << "[model cache] wrote " << cachePath << std::endl;
+    return true;
+}
@@ -1,6 +1,8 @@
 #include "node.h"
 #include "shape.h"
 #include "physicShapeObject.h"
+#include "instancedRenderer.h"
+#include "renderQueue.h"
 #include <iostream>
 
 Node::Node(const glm::mat4& transform) :
@@ -42,15 +44,38 @@ void Node::draw(glm::mat4& model, glm::mat4& view, glm::mat4& projection) {
         child->draw(updatedModel, view, projection);
     }
 
+    // shapes are sorted and drawn by the RenderQueue at the end of the pass
     for (auto child : children_shape_) {
-        child->draw(updatedModel, view, projection);
+        if (!RenderQueue::Submit(child, updatedModel)) {
+            child->draw(updatedModel, view, projection);
+        }
     }
 
     for (auto child : children_physic_shape_) {
-        child->draw(view, projection);
+        if (child->enabled) child->draw(view, projection);
     }
 
 }
+// Same traversal as draw, but shapes are queued in the InstancedRenderer
+// and drawn later in one call per shared geometry.
+void Node::submitInstances(glm::mat4& model, glm::mat4& view, glm::mat4& projection) {
+    glm::mat4 updatedModel = model * transform_;
+
+    for (auto child : children_) {
+        child->submitInstances(updatedModel, view, projection);
+    }
+
+    for (auto child : children_shape_) {
+        if (!InstancedRenderer::Submit(child, updatedModel) && !RenderQueue::Submit(child, updatedModel)) {
+            child->draw(updatedModel, view, projection);
+        }
+    }
+
+    for (auto child : children_physic_shape_) {
+        if (child->enabled) child->draw(view, projection);
+    }
+}
+
 // Clone the node and its children
 Node* Node::clone() const {
     Node* newNode = new Node(this->transform_);
@@ -125,4 +150,4 @@ void Node::recursiveReset() {
     for (auto child : children_) {
         child->recursiveReset();
     }
-}
\ No newline at end of file
+}
\ No newline at end of file
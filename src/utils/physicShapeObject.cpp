@@ -1,5 +1,7 @@
 #include "physicShapeObject.h"
 #include "shape.h"
+#include "instancedRenderer.h"
+#include "renderQueue.h"
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -35,5 +37,11 @@ void PhysicShapeObject::draw(glm::mat4& view,glm::mat4& projection)
 	model *= RotationMatrix; // Apply rotation
 
     // Draw the shape with model/view/projection
+    if (instanced && InstancedRenderer::Submit(shape, model)) {
+        return;
+    }
+    if (RenderQueue::Submit(shape, model)) {
+        return;
+    }
     shape->draw(model, view, projection);
 }
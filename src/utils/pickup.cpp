@@ -17,12 +17,12 @@ void Pickup::BeforeCollide(PhysicObject* other, CollisionInfo info, float deltaT
 	if (toBeDeleted || !info.hit) return;
 	Player* player = static_cast<Player*>(other);
 	if (player) {
-		if (name == "HealthPack") {
-			player->heal(25.0f);
-		}
-		else {
+		if (effect != StatusEffect::None) {
 			player->AddPickup(this, lifetime);
 		}
+		else if (name == "HealthPack") {
+			player->heal(25.0f);
+		}
 		toBeDeleted = true;
 	}
 }
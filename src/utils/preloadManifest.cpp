@@ -0,0 +1,84 @@
+#include "preloadManifest.h"
+#include "resourceManager.h"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+// initialize static variables
+std::vector<PreloadEntry> PreloadManifest::entries;
+
+bool PreloadManifest::Load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open preload manifest: " << path << std::endl;
+        return false;
+    }
+
+    entries.clear();
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+
+        // skip comments and empty lines
+        size_t start = line.find_first_not_of(" \t");
+        if (start == std::string::npos || line[start] == '#') continue;
+
+        std::istringstream stream(line);
+        std::string type;
+        stream >> type;
+
+        PreloadEntry entry;
+        bool valid = false;
+        if (type == "model") {
+            std::string retention;
+            entry.type = PreloadEntry::Type::Model;
+            valid = static_cast<bool>(stream >> entry.name >> entry.file >> retention) && (retention == "keep" || retention == "release");
+            entry.retention = retention == "keep" ? GeometryRetention::Keep : GeometryRetention::Release;
+        } else if (type == "texture") {
+            entry.type = PreloadEntry::Type::Texture;
+            valid = static_cast<bool>(stream >> entry.name >> entry.file);
+        } else if (type == "font") {
+            entry.type = PreloadEntry::Type::Font;
+            valid = static_cast<bool>(stream >> entry.file >> entry.fontSize);
+            entry.name = entry.file;
+        }
+
+        if (!valid) {
+            std::cerr << path << ":" << lineNumber << ": expected 'model <name> <file> <keep|release>', "
+                      << "'texture <name> <file>' or 'font <file> <size>'" << std::endl;
+            continue;
+        }
+        entries.push_back(entry);
+    }
+
+    std::cout << "[preload] " << entries.size() << " entries loaded from " << path << std::endl;
+    return true;
+}
+
+std::vector<AssetHandle> PreloadManifest::Request(Shader* shader, TextRenderer* textRenderer) {
+    std::string imageDir = IMAGE_DIR;
+    std::string fontDir = FONT_DIR;
+
+    std::vector<AssetHandle> handles;
+    for (const PreloadEntry& entry : entries) {
+        switch (entry.type) {
+        case PreloadEntry::Type::Model:
+            if (ResourceManager::GetModel(entry.name) != nullptr) continue;
+            handles.push_back(AssetLoader::LoadModelAsync(imageDir + entry.file, entry.name, shader, entry.retention));
+            break;
+        case PreloadEntry::Type::Texture:
+            if (ResourceManager::GetTexture(entry.name) != 0) continue;
+            handles.push_back(AssetLoader::LoadTextureAsync(imageDir + entry.file, entry.name));
+            break;
+        case PreloadEntry::Type::Font:
+            // glyphs belong to the renderer, every new renderer needs its own upload
+            if (textRenderer == nullptr) continue;
+            handles.push_back(AssetLoader::LoadFontAsync(textRenderer, fontDir + entry.file, entry.fontSize));
+            break;
+        }
+    }
+    return handles;
+}
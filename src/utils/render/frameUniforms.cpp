@@ -0,0 +1,60 @@
+#include "frameUniforms.h"
+#include <vector>
+#include <cstring>
+
+// initialize static variables
+GLuint     FrameUniforms::ubo = 0;
+GLsizeiptr FrameUniforms::slotSize = 0;
+FrameData  FrameUniforms::passes[FrameUniforms::PassCount];
+glm::vec4  FrameUniforms::fogColor = glm::vec4(0.0f);
+glm::vec4  FrameUniforms::fogRange = glm::vec4(0.0f);
+
+void FrameUniforms::Init() {
+    if (ubo != 0) return;
+
+    // bound ranges must start on the driver's offset alignment
+    GLint alignment = 256;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    if (alignment <= 0) alignment = 256;
+    slotSize = ((static_cast<GLsizeiptr>(sizeof(FrameData)) + alignment - 1) / alignment) * alignment;
+
+    glGenBuffers(1, &ubo);
+    glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+    glBufferData(GL_UNIFORM_BUFFER, slotSize * PassCount, nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void FrameUniforms::SetFog(const glm::vec4& color, float start, float end) {
+    fogColor = color;
+    fogRange = glm::vec4(start, end, 0.0f, 0.0f);
+}
+
+void FrameUniforms::SetPass(Pass pass, const glm::mat4& view, const glm::mat4& projection,
+                            const glm::mat4& lightSpaceMatrix, const glm::vec3& viewPos, const glm::vec3& sunPos) {
+    FrameData& data = passes[pass];
+    data.view = view;
+    data.projection = projection;
+    data.lightSpaceMatrix = lightSpaceMatrix;
+    data.viewPos = glm::vec4(viewPos, 1.0f);
+    data.fogColor = fogColor;
+    data.fogRange = fogRange;
+    data.sunPos = glm::vec4(sunPos, 1.0f);
+    data.isShadowPass = (pass == ShadowPass);
+}
+
+void FrameUniforms::Upload() {
+    static std::vector<unsigned char> staging;
+    staging.assign(static_cast<size_t>(slotSize * PassCount), 0);
+    for (int i = 0; i < PassCount; i++) {
+        std::memcpy(staging.data() + i * slotSize, &passes[i], sizeof(FrameData));
+    }
+
+    // one upload for every pass of the frame
+    glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, slotSize * PassCount, staging.data());
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void FrameUniforms::Bind(Pass pass) {
+    glBindBufferRange(GL_UNIFORM_BUFFER, BindingPoint, ubo, pass * slotSize, sizeof(FrameData));
+}
@@ -0,0 +1,121 @@
+#include "instancedRenderer.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <cstddef>
+
+// initialize static variables
+bool                                        InstancedRenderer::Enabled = true;
+Shader*                                     InstancedRenderer::shader = nullptr;
+GLuint                                      InstancedRenderer::instanceVBO = 0;
+std::vector<InstancedRenderer::Batch>       InstancedRenderer::batches;
+std::map<InstancedRenderer::BatchKey, size_t> InstancedRenderer::batchIndex;
+int                                         InstancedRenderer::drawCalls = 0;
+int                                         InstancedRenderer::instanceCount = 0;
+
+void InstancedRenderer::Init(Shader* instancedShader) {
+    shader = instancedShader;
+    if (instanceVBO == 0) {
+        glGenBuffers(1, &instanceVBO);
+    }
+}
+
+InstancedRenderer::Batch* InstancedRenderer::batchFor(const Shape* shape, DrawGeometry& geometry) {
+    if (!Enabled || !shader || !shape) return nullptr;
+
+    geometry = shape->getGeometry();
+    if (geometry.VAO == 0 || geometry.indexCount == 0) return nullptr;
+
+    bool transparent = shape->alpha < 1.0f;
+    BatchKey key(geometry.VAO, shape->isEmissive, transparent);
+
+    auto it = batchIndex.find(key);
+    size_t index;
+    if (it == batchIndex.end()) {
+        index = batches.size();
+        batches.push_back(Batch{ geometry, shape->isEmissive, transparent, {} });
+        batchIndex[key] = index;
+    } else {
+        index = it->second;
+    }
+    return &batches[index];
+}
+
+bool InstancedRenderer::Submit(const Shape* shape, const glm::mat4& model) {
+    DrawGeometry geometry;
+    Batch* batch = batchFor(shape, geometry);
+    if (!batch) return false;
+
+    glm::mat4 instanceModel = geometry.localTransform(model);
+    batch->instances.push_back(InstanceData{ instanceModel, glm::vec4(shape->getColor(), shape->alpha) });
+    return true;
+}
+
+bool InstancedRenderer::SubmitMany(const Shape* shape, const glm::mat4* models, size_t count, const glm::mat4& local) {
+    DrawGeometry geometry;
+    Batch* batch = batchFor(shape, geometry);
+    if (!batch) return false;
+
+    // the shape's scale and offset fold into the shared local part
+    glm::mat4 meshLocal = geometry.localTransform(local);
+    glm::vec4 colorAlpha(shape->getColor(), shape->alpha);
+    batch->instances.reserve(batch->instances.size() + count);
+    for (size_t i = 0; i < count; i++) {
+        batch->instances.push_back(InstanceData{ models[i] * meshLocal, colorAlpha });
+    }
+    return true;
+}
+
+void InstancedRenderer::Flush(bool shadowPass) {
+    drawCalls = 0;
+    instanceCount = 0;
+    if (!shader) return;
+
+    // view and projection come from the FrameData uniform buffer
+    glUseProgram(shader->get_id());
+    glUniform1i(shader->location(Uniform::UseCheckerboard), 0);
+
+    // opaque groups first, then transparent ones without depth writes
+    for (Batch& batch : batches) {
+        if (!batch.transparent) drawBatch(batch);
+    }
+
+    glDepthMask(GL_FALSE);
+    for (Batch& batch : batches) {
+        // transparent shapes never wrote depth in the shadow pass
+        if (batch.transparent && !shadowPass) drawBatch(batch);
+    }
+    glDepthMask(GL_TRUE);
+
+    for (Batch& batch : batches) {
+        batch.instances.clear();
+    }
+    glBindVertexArray(0);
+}
+
+void InstancedRenderer::drawBatch(Batch& batch) {
+    if (batch.instances.empty()) return;
+
+    glUniform1i(shader->location(Uniform::IsEmissive), batch.emissive);
+
+    glBindVertexArray(batch.geometry.VAO);
+
+    // orphan and refill the instance buffer
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    glBufferData(GL_ARRAY_BUFFER, batch.instances.size() * sizeof(InstanceData), batch.instances.data(), GL_STREAM_DRAW);
+
+    // model matrix, one vec4 column per attribute slot
+    for (int i = 0; i < 4; i++) {
+        glEnableVertexAttribArray(4 + i);
+        glVertexAttribPointer(4 + i, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceData), (void*)(offsetof(InstanceData, model) + i * sizeof(glm::vec4)));
+        glVertexAttribDivisor(4 + i, 1);
+    }
+
+    // color and alpha
+    glEnableVertexAttribArray(8);
+    glVertexAttribPointer(8, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceData), (void*)offsetof(InstanceData, colorAlpha));
+    glVertexAttribDivisor(8, 1);
+
+    glDrawElementsInstanced(GL_TRIANGLES, batch.geometry.indexCount, batch.geometry.indexType, 0, static_cast<GLsizei>(batch.instances.size()));
+
+    drawCalls++;
+    instanceCount += static_cast<int>(batch.instances.size());
+}
@@ -0,0 +1,138 @@
+#include "nullRenderer.h"
+#include <glad/glad.h>
+
+// initialize static variables
+bool NullRenderer::installed = false;
+
+// object names are never reused, nothing reads them back
+static GLuint nextName = 1;
+
+// a no-op for any GL signature, returning a zero value
+template <typename Proc>
+struct NullProc;
+
+template <typename R, typename... Args>
+struct NullProc<R (APIENTRYP)(Args...)> {
+    static R APIENTRY call(Args...) { return R(); }
+};
+
+template <typename Proc>
+static void stub(Proc& proc) {
+    proc = &NullProc<Proc>::call;
+}
+
+static void APIENTRY genNames(GLsizei n, GLuint* names) {
+    for (GLsizei i = 0; i < n; i++) names[i] = nextName++;
+}
+
+static GLuint APIENTRY createName() {
+    return nextName++;
+}
+
+static GLuint APIENTRY createShader(GLenum) {
+    return nextName++;
+}
+
+// every shader compiles and every program links
+static void APIENTRY getObjectiv(GLuint, GLenum, GLint* params) {
+    *params = GL_TRUE;
+}
+
+static void APIENTRY getInfoLog(GLuint, GLsizei bufSize, GLsizei* length, GLchar* infoLog) {
+    if (length) *length = 0;
+    if (bufSize > 0) infoLog[0] = '\0';
+}
+
+static void APIENTRY getIntegerv(GLenum pname, GLint* data) {
+    *data = pname == GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT ? 256 : 0;
+}
+
+static const GLubyte* APIENTRY getString(GLenum) {
+    return reinterpret_cast<const GLubyte*>("null");
+}
+
+// no program has a FrameData block, the binding is skipped
+static GLuint APIENTRY getUniformBlockIndex(GLuint, const GLchar*) {
+    return GL_INVALID_INDEX;
+}
+
+static GLenum APIENTRY checkFramebufferStatus(GLenum) {
+    return GL_FRAMEBUFFER_COMPLETE;
+}
+
+void NullRenderer::Install() {
+    // state, buffers and draws
+    stub(glad_glEnable);
+    stub(glad_glDisable);
+    stub(glad_glBlendFunc);
+    stub(glad_glCullFace);
+    stub(glad_glDepthFunc);
+    stub(glad_glDepthMask);
+    stub(glad_glViewport);
+    stub(glad_glClear);
+    stub(glad_glClearColor);
+    stub(glad_glDrawBuffer);
+    stub(glad_glReadBuffer);
+    stub(glad_glPixelStorei);
+    stub(glad_glBindVertexArray);
+    stub(glad_glBindBuffer);
+    stub(glad_glBindBufferRange);
+    stub(glad_glBufferData);
+    stub(glad_glBufferSubData);
+    stub(glad_glEnableVertexAttribArray);
+    stub(glad_glVertexAttribPointer);
+    stub(glad_glVertexAttribDivisor);
+    stub(glad_glDeleteVertexArrays);
+    stub(glad_glDeleteBuffers);
+    stub(glad_glDrawArrays);
+    stub(glad_glDrawElements);
+    stub(glad_glDrawElementsInstanced);
+    stub(glad_glMultiDrawElements);
+
+    // textures and framebuffers
+    stub(glad_glActiveTexture);
+    stub(glad_glBindTexture);
+    stub(glad_glTexImage2D);
+    stub(glad_glTexParameteri);
+    stub(glad_glTexParameterfv);
+    stub(glad_glGenerateMipmap);
+    stub(glad_glDeleteTextures);
+    stub(glad_glBindFramebuffer);
+    stub(glad_glFramebufferTexture2D);
+
+    // programs and uniforms
+    stub(glad_glShaderSource);
+    stub(glad_glCompileShader);
+    stub(glad_glAttachShader);
+    stub(glad_glLinkProgram);
+    stub(glad_glDeleteShader);
+    stub(glad_glDeleteProgram);
+    stub(glad_glUseProgram);
+    stub(glad_glGetUniformLocation);
+    stub(glad_glUniformBlockBinding);
+    stub(glad_glUniform1i);
+    stub(glad_glUniform1f);
+    stub(glad_glUniform1fv);
+    stub(glad_glUniform3f);
+    stub(glad_glUniform3fv);
+    stub(glad_glUniformMatrix3fv);
+    stub(glad_glUniformMatrix4fv);
+
+    // the few calls whose results the engine reads
+    glad_glGenBuffers = genNames;
+    glad_glGenVertexArrays = genNames;
+    glad_glGenTextures = genNames;
+    glad_glGenFramebuffers = genNames;
+    glad_glCreateProgram = createName;
+    glad_glCreateShader = createShader;
+    glad_glGetShaderiv = getObjectiv;
+    glad_glGetProgramiv = getObjectiv;
+    glad_glGetShaderInfoLog = getInfoLog;
+    glad_glGetProgramInfoLog = getInfoLog;
+    glad_glGetIntegerv = getIntegerv;
+    glad_glGetString = getString;
+    glad_glGetUniformBlockIndex = getUniformBlockIndex;
+    glad_glCheckFramebufferStatus = checkFramebufferStatus;
+
+    installed = true;
+}
@@ -0,0 +1,153 @@
+#include "renderQueue.h"
+#include "mesh.h"
+#include <glm/gtc/type_ptr.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+
+// initialize static variables
+bool                                        RenderQueue::Enabled = true;
+std::vector<RenderQueue::Item>              RenderQueue::items;
+std::vector<std::pair<uint64_t, uint32_t>>  RenderQueue::keys[2];
+glm::vec3                                   RenderQueue::eye = glm::vec3(0.0f);
+glm::mat4                                   RenderQueue::view = glm::mat4(1.0f);
+glm::mat4                                   RenderQueue::projection = glm::mat4(1.0f);
+RenderStats                                 RenderQueue::stats;
+RenderStats                                 RenderQueue::lastFrame;
+GLuint                                      RenderQueue::boundTextures[8] = { 0 };
+GLenum                                      RenderQueue::activeUnit = GL_TEXTURE0;
+
+// depth is quantized on 23 bits over this distance
+static const float MAX_SORT_DEPTH = 500.0f;
+static const uint64_t DEPTH_MASK = (1ull << 23) - 1;
+
+void RenderQueue::Begin(const glm::vec3& eyePos, glm::mat4& viewMatrix, glm::mat4& projectionMatrix) {
+    eye = eyePos;
+    view = viewMatrix;
+    projection = projectionMatrix;
+    items.clear();
+    keys[Opaque].clear();
+    keys[Transparent].clear();
+}
+
+bool RenderQueue::Submit(const Shape* shape, const glm::mat4& model) {
+    if (!Enabled || !shape) return false;
+
+    DrawGeometry geometry = shape->getGeometry();
+    if (geometry.VAO == 0 || geometry.indexCount == 0) return false;
+
+    Item item{ shape, shape->getShader(), geometry, geometry.localTransform(model) };
+
+    // meshes sort by their material table entry, primitives only by color state
+    const Mesh* mesh = dynamic_cast<const Mesh*>(shape);
+    uint16_t material = mesh ? mesh->data->materialID : 0;
+
+    float depth = glm::length(glm::vec3(item.model[3]) - eye);
+    Layer layer = shape->alpha < 1.0f ? Transparent : Opaque;
+
+    keys[layer].emplace_back(makeKey(layer, item, material, depth), static_cast<uint32_t>(items.size()));
+    items.push_back(item);
+    return true;
+}
+
+uint64_t RenderQueue::makeKey(Layer layer, const Item& item, uint16_t material, float depth) {
+    uint64_t quantized = static_cast<uint64_t>(glm::clamp(depth / MAX_SORT_DEPTH, 0.0f, 1.0f) * DEPTH_MASK);
+    uint64_t program = item.shader->get_id() & 0xFF;
+    uint64_t vao = item.geometry.VAO & 0xFFFF;
+
+    if (layer == Opaque) {
+        // state first, front-to-back inside identical state
+        return (program << 55) | (uint64_t(material) << 39) | (vao << 23) | quantized;
+    }
+    // back-to-front first, state only breaks depth ties
+    return (1ull << 63) | ((DEPTH_MASK - quantized) << 40) | (program << 32) | (uint64_t(material) << 16) | vao;
+}
+
+void RenderQueue::Flush(Layer layer) {
+    std::vector<std::pair<uint64_t, uint32_t>>& sorted = keys[layer];
+    std::sort(sorted.begin(), sorted.end());
+
+    if (layer == Transparent && !sorted.empty()) {
+        glDepthMask(GL_FALSE);
+    }
+
+    // other renderers may have changed the bindings since the last flush
+    Shader* currentShader = nullptr;
+    GLuint currentVAO = 0;
+    MaterialState currentMaterial{};
+    bool materialValid = false;
+
+    for (const auto& entry : sorted) {
+        const Item& item = items[entry.second];
+        const Shape* shape = item.shape;
+
+        if (item.shader != currentShader) {
+            currentShader = item.shader;
+            glUseProgram(currentShader->get_id());
+            stats.programBinds++;
+            materialValid = false;
+
+            // programs without the FrameData block still take view/projection as uniforms
+            GLint loc = currentShader->location(Uniform::View);
+            if (loc != -1) glUniformMatrix4fv(loc, 1, GL_FALSE, glm::value_ptr(view));
+            loc = currentShader->location(Uniform::Projection);
+            if (loc != -1) glUniformMatrix4fv(loc, 1, GL_FALSE, glm::value_ptr(projection));
+        }
+
+        MaterialState material{ shape->getColor(), shape->alpha, shape->useCheckerboard, shape->isEmissive };
+        if (!materialValid || !(material == currentMaterial)) {
+            glUniform3fv(currentShader->location(Uniform::ObjectColor), 1, glm::value_ptr(material.color));
+            glUniform1f(currentShader->location(Uniform::Alpha), material.alpha);
+            glUniform1i(currentShader->location(Uniform::UseCheckerboard), material.useCheckerboard);
+            glUniform1i(currentShader->location(Uniform::IsEmissive), material.isEmissive);
+            currentMaterial = material;
+            materialValid = true;
+            stats.materialChanges++;
+        }
+
+        glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(item.model)));
+        glUniformMatrix4fv(currentShader->location(Uniform::Model), 1, GL_FALSE, glm::value_ptr(item.model));
+        glUniformMatrix3fv(currentShader->location(Uniform::NormalMatrix), 1, GL_FALSE, glm::value_ptr(normalMatrix));
+
+        if (item.geometry.VAO != currentVAO) {
+            currentVAO = item.geometry.VAO;
+            glBindVertexArray(currentVAO);
+            stats.vaoBinds++;
+        }
+
+        glDrawElements(GL_TRIANGLES, item.geometry.indexCount, item.geometry.indexType, 0);
+        stats.drawCalls++;
+    }
+
+    if (layer == Transparent && !sorted.empty()) {
+        glDepthMask(GL_TRUE);
+    }
+    glBindVertexArray(0);
+    sorted.clear();
+}
+
+void RenderQueue::BindTexture(GLenum unit, GLenum target, GLuint texture) {
+    // callers upload to the bound texture, the unit must be active even when the bind is skipped
+    if (unit != activeUnit) {
+        glActiveTexture(unit);
+        activeUnit = unit;
+    }
+    GLuint slot = unit - GL_TEXTURE0;
+    if (slot < 8 && boundTextures[slot] == texture) return;
+
+    glBindTexture(target, texture);
+    if (slot < 8) boundTextures[slot] = texture;
+    stats.textureBinds++;
+}
+
+void RenderQueue::DeleteTexture(GLuint texture) {
+    glDeleteTextures(1, &texture);
+    // GL may hand the name out again, a stale entry would skip its first bind
+    for (GLuint& bound : boundTextures) {
+        if (bound == texture) bound = 0;
+    }
+}
+
+void RenderQueue::ResetStats() {
+    lastFrame = stats;
+    stats = RenderStats();
+}
@@ -0,0 +1,172 @@
+#include "staticBatch.h"
+#include "node.h"
+#include "mesh.h"
+#include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <cfloat>
+#include <iostream>
+
+// floats per baked vertex: position and normal, only what the lit shaders read
+static const size_t BATCH_VERTEX_FLOATS = 6;
+
+struct SourceMesh {
+    const MeshData* data;
+    glm::mat4 transform;
+};
+
+// collect every mesh of the hierarchy with its world transform
+static void collectMeshes(Node* node, const glm::mat4& parentTransform, std::vector<SourceMesh>& out) {
+    glm::mat4 transform = parentTransform * node->get_transform();
+
+    for (Shape* shape : node->getShapes()) {
+        const Mesh* mesh = dynamic_cast<const Mesh*>(shape);
+        if (!mesh) continue;
+        if (!mesh->data->hasCpuData()) {
+            std::cerr << "[static batch] skipping mesh without CPU data: " << mesh->data->materialName << std::endl;
+            continue;
+        }
+        out.push_back(SourceMesh{ mesh->data.get(), transform });
+    }
+    for (Node* child : node->getChildren()) {
+        collectMeshes(child, transform, out);
+    }
+}
+
+// frustum planes (a, b, c, d) of a clip matrix, Gribb/Hartmann
+static void extractFrustum(const glm::mat4& m, glm::vec4 planes[6]) {
+    glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+    glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+    glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+    glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+    planes[0] = row3 + row0; // left
+    planes[1] = row3 - row0; // right
+    planes[2] = row3 + row1; // bottom
+    planes[3] = row3 - row1; // top
+    planes[4] = row3 + row2; // near
+    planes[5] = row3 - row2; // far
+}
+
+static bool aabbInFrustum(const glm::vec4 planes[6], const glm::vec3& aabbMin, const glm::vec3& aabbMax) {
+    for (int i = 0; i < 6; i++) {
+        // corner furthest along the plane normal
+        glm::vec3 p(planes[i].x >= 0.0f ? aabbMax.x : aabbMin.x,
+                    planes[i].y >= 0.0f ? aabbMax.y : aabbMin.y,
+                    planes[i].z >= 0.0f ? aabbMax.z : aabbMin.z);
+        if (glm::dot(glm::vec3(planes[i]), p) + planes[i].w < 0.0f) return false;
+    }
+    return true;
+}
+
+StaticBatch::StaticBatch(Shader* shader, Node* root)
+    : Shape(shader), vertexCount(0), indexCount(0), sourceMeshes(0), lastDrawCalls(0), lastVisibleRanges(0)
+{
+    std::vector<SourceMesh> sources;
+    if (root) collectMeshes(root, glm::mat4(1.0f), sources);
+    sourceMeshes = static_cast<int>(sources.size());
+
+    // meshes of a material end up next to each other in the index buffer
+    std::stable_sort(sources.begin(), sources.end(), [](const SourceMesh& a, const SourceMesh& b) {
+        return a.data->materialID < b.data->materialID;
+    });
+
+    std::vector<float> vertices;
+    std::vector<unsigned int> indices;
+
+    for (const SourceMesh& source : sources) {
+        const MeshData* data = source.data;
+        glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(source.transform)));
+        unsigned int base = static_cast<unsigned int>(vertices.size() / BATCH_VERTEX_FLOATS);
+
+        // pre-transform into world space
+        Range range;
+        range.aabbMin = glm::vec3(FLT_MAX);
+        range.aabbMax = glm::vec3(-FLT_MAX);
+        for (const Vertex& v : data->vertices) {
+            glm::vec3 position = glm::vec3(source.transform * glm::vec4(v.Position, 1.0f));
+            glm::vec3 normal = glm::normalize(normalMatrix * v.Normal);
+            range.aabbMin = glm::min(range.aabbMin, position);
+            range.aabbMax = glm::max(range.aabbMax, position);
+            vertices.insert(vertices.end(), { position.x, position.y, position.z, normal.x, normal.y, normal.z });
+        }
+
+        range.indexOffset = indices.size() * sizeof(unsigned int);
+        range.indexCount = static_cast<GLsizei>(data->indices.size());
+        for (unsigned int index : data->indices) {
+            indices.push_back(base + index);
+        }
+
+        if (groups.empty() || groups.back().material != data->materialID) {
+            groups.push_back(MaterialGroup{ data->materialID, {} });
+        }
+        groups.back().ranges.push_back(range);
+    }
+
+    vertexCount = vertices.size() / BATCH_VERTEX_FLOATS;
+    indexCount = indices.size();
+
+    // same interleaved layout as the generated primitives
+    geometry = std::make_shared<const PrimitiveGeometry>(vertices, indices);
+
+    std::cout << "[static batch] " << sourceMeshes << " meshes merged into " << groups.size()
+              << " material groups, " << gpuBytes() / 1024 << " KB on GPU" << std::endl;
+}
+
+size_t StaticBatch::gpuBytes() const {
+    return vertexCount * BATCH_VERTEX_FLOATS * sizeof(float) + indexCount * sizeof(unsigned int);
+}
+
+void StaticBatch::draw(glm::mat4& model, glm::mat4& view, glm::mat4& projection) {
+    lastDrawCalls = 0;
+    lastVisibleRanges = 0;
+    if (groups.empty()) return;
+
+    glUseProgram(shader_program_);
+
+    glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(model)));
+    glUniformMatrix4fv(shader_->location(Uniform::Model), 1, GL_FALSE, glm::value_ptr(model));
+    glUniformMatrix3fv(shader_->location(Uniform::NormalMatrix), 1, GL_FALSE, glm::value_ptr(normalMatrix));
+    glUniform1i(shader_->location(Uniform::UseCheckerboard), useCheckerboard);
+    glUniform1i(shader_->location(Uniform::IsEmissive), isEmissive);
+    glUniform1f(shader_->location(Uniform::Alpha), alpha);
+
+    // programs reading the FrameData block get view/projection from the uniform buffer
+    GLint loc = shader_->location(Uniform::View);
+    if (loc != -1) glUniformMatrix4fv(loc, 1, GL_FALSE, glm::value_ptr(view));
+    loc = shader_->location(Uniform::Projection);
+    if (loc != -1) glUniformMatrix4fv(loc, 1, GL_FALSE, glm::value_ptr(projection));
+
+    // ranges are in world space, cull them against the frustum of this pass
+    glm::vec4 planes[6];
+    extractFrustum(projection * view * model, planes);
+
+    glBindVertexArray(geometry->VAO);
+
+    for (const MaterialGroup& group : groups) {
+        drawCounts.clear();
+        drawOffsets.clear();
+
+        size_t nextOffset = 0;
+        for (const Range& range : group.ranges) {
+            if (!aabbInFrustum(planes, range.aabbMin, range.aabbMax)) continue;
+            lastVisibleRanges++;
+
+            // ranges that follow each other in the buffer become one draw
+            if (!drawCounts.empty() && range.indexOffset == nextOffset) {
+                drawCounts.back() += range.indexCount;
+            } else {
+                drawCounts.push_back(range.indexCount);
+                drawOffsets.push_back(reinterpret_cast<const void*>(range.indexOffset));
+            }
+            nextOffset = range.indexOffset + range.indexCount * sizeof(unsigned int);
+        }
+        if (drawCounts.empty()) continue;
+
+        glm::vec3 groupColor = MaterialTable::Get(group.material).color;
+        glUniform3fv(shader_->location(Uniform::ObjectColor), 1, glm::value_ptr(groupColor));
+        glMultiDrawElements(GL_TRIANGLES, drawCounts.data(), GL_UNSIGNED_INT, drawOffsets.data(), static_cast<GLsizei>(drawCounts.size()));
+        lastDrawCalls++;
+    }
+
+    glBindVertexArray(0);
+}
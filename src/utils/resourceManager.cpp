@@ -1,4 +1,7 @@
 #include "resourceManager.h"
+#include "primitiveCache.h"
+#include "hitchDetector.h"
+#include "renderQueue.h"
 #include <iostream>
 #include <stb_image.h>
 
@@ -9,6 +12,7 @@ std::map<std::string, Model*>        ResourceManager::Models;
 
 
 Shader* ResourceManager::LoadShader(std::string vShaderFile, std::string fShaderFile, std::string name){
+    LoadScope scope("shader " + name);
     Shaders[name] = new Shader(vShaderFile.c_str(), fShaderFile.c_str());
     return Shaders[name];
 }
@@ -17,6 +21,7 @@ Shader* ResourceManager::GetShader(std::string name){
 }
 
 unsigned int ResourceManager::LoadTexture(std::string file, std::string name){
+    LoadScope scope("texture " + name);
     stbi_set_flip_vertically_on_load(true);
     unsigned int textureID = loadTextureFromFile(file.c_str());
     Textures[name] = textureID;
@@ -29,44 +34,66 @@ unsigned int ResourceManager::GetTexture(std::string name){
 
 void ResourceManager::Clear() {
     for (auto iter : Shaders) glDeleteProgram(iter.second->get_id());
-    for (auto iter : Textures) glDeleteTextures(1, &iter.second);
+    for (auto iter : Textures) RenderQueue::DeleteTexture(iter.second);
     for (auto iter : Models) delete iter.second;
+    PrimitiveCache::Clear();
 }
 
 unsigned int ResourceManager::loadTextureFromFile(const char* file){
-    unsigned int textureID;
-    glGenTextures(1, &textureID);
     int width, height, nrComponents;
 
     unsigned char* data = stbi_load(file, &width, &height, &nrComponents, 4);
-    if (data){
-        GLenum format = GL_RGBA;
+    unsigned int textureID = CreateTexture(data, width, height);
+    /* if (!data) std::cout << "Texture failed to load at path: " << file << std::endl; */
+    stbi_image_free(data);
+    return textureID;
+}
 
-        glBindTexture(GL_TEXTURE_2D, textureID);
-        glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-        glGenerateMipmap(GL_TEXTURE_2D);
+unsigned int ResourceManager::CreateTexture(const unsigned char* pixels, int width, int height) {
+    unsigned int textureID;
+    glGenTextures(1, &textureID);
+    if (!pixels) return textureID;
 
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    GLenum format = GL_RGBA;
 
-        stbi_image_free(data);
-    }
-    else
-    {
-        /* std::cout << "Texture failed to load at path: " << file << std::endl; */
-        stbi_image_free(data);
-    }
+    RenderQueue::BindTexture(GL_TEXTURE0, GL_TEXTURE_2D, textureID);
+    glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, pixels);
+    glGenerateMipmap(GL_TEXTURE_2D);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     return textureID;
 }
 
-Model* ResourceManager::LoadModel(std::string file, std::string name, Shader* shader) {
-    Models[name] = new Model(file, shader);
+Model* ResourceManager::LoadModel(std::string file, std::string name, Shader* shader, GeometryRetention retention) {
+    LoadScope scope("model " + name);
+    Models[name] = new Model(file, shader, retention);
     return Models[name];
 }
 
 Model* ResourceManager::GetModel(std::string name) {
     return Models[name];
+}
+
+void ResourceManager::ReleaseModel(std::string name) {
+    auto iter = Models.find(name);
+    if (iter == Models.end()) return;
+    delete iter->second;
+    Models.erase(iter);
+}
+
+void ResourceManager::LogGeometryMemory() {
+    size_t totalResident = 0;
+    for (auto& iter : Models) {
+        if (!iter.second) continue;
+        size_t resident = iter.second->residentGeometryBytes();
+        size_t gpu = iter.second->gpuGeometryBytes();
+        totalResident += resident;
+        std::cout << "[geometry] " << iter.first << ": " << resident / 1024 << " KB resident, "
+                  << gpu / 1024 << " KB on GPU" << std::endl;
+    }
+    std::cout << "[geometry] total: " << totalResident / 1024 << " KB resident" << std::endl;
 }
\ No newline at end of file
@@ -0,0 +1,214 @@
+#include "primitiveCache.h"
+#include "hitchDetector.h"
+
+#include <glm/glm.hpp>
+#include "glm/ext.hpp"
+#include <cmath>
+
+// initialize static variables
+std::map<PrimitiveCache::Key, std::shared_ptr<const PrimitiveGeometry>> PrimitiveCache::cache;
+
+PrimitiveGeometry::PrimitiveGeometry(const std::vector<float>& vertices, const std::vector<unsigned int>& indices) {
+    glGenVertexArrays(1, &VAO);
+    glBindVertexArray(VAO);
+    glGenBuffers(2, &buffers[0]);
+
+    // create vertex buffer
+    glBindBuffer(GL_ARRAY_BUFFER, buffers[0]);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+
+    // Position attribute
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    // Normal attribute
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+
+    // create index buffer
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffers[1]);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+    num_indices = static_cast<unsigned int>(indices.size());
+
+    glBindVertexArray(0);
+}
+
+PrimitiveGeometry::~PrimitiveGeometry() {
+    glDeleteVertexArrays(1, &VAO);
+    glDeleteBuffers(2, &buffers[0]);
+}
+
+std::shared_ptr<const PrimitiveGeometry> PrimitiveCache::GetSphere(int slices) {
+    Key key(PrimitiveType::Sphere, 1.0f, slices, slices);
+    auto it = cache.find(key);
+    if (it != cache.end()) return it->second;
+    LoadScope scope("sphere primitive");
+    return cache[key] = buildSphere(slices);
+}
+
+std::shared_ptr<const PrimitiveGeometry> PrimitiveCache::GetBox() {
+    Key key(PrimitiveType::Box, 1.0f, 1, 1);
+    auto it = cache.find(key);
+    if (it != cache.end()) return it->second;
+    LoadScope scope("box primitive");
+    return cache[key] = buildBox();
+}
+
+std::shared_ptr<const PrimitiveGeometry> PrimitiveCache::GetCapsule(float heightOverRadius, unsigned int segments, unsigned int rings) {
+    Key key(PrimitiveType::Capsule, heightOverRadius, static_cast<int>(segments), static_cast<int>(rings));
+    auto it = cache.find(key);
+    if (it != cache.end()) return it->second;
+    LoadScope scope("capsule primitive");
+    return cache[key] = buildCapsule(heightOverRadius, segments, rings);
+}
+
+void PrimitiveCache::Clear() {
+    // shapes still alive keep their geometry through the shared pointer
+    cache.clear();
+}
+
+std::shared_ptr<const PrimitiveGeometry> PrimitiveCache::buildSphere(int slices) {
+    // generate vertices
+    std::vector<float> vertices;
+    for (int i = 0; i <= slices; i++) {
+        float theta = glm::pi<float>() * static_cast<float>(i) / static_cast<float>(slices);
+        for (int j = 0; j <= slices; j++) {
+            float phi = 2.0f * glm::pi<float>() * static_cast<float>(j) / static_cast<float>(slices);
+            float x = glm::sin(theta) * glm::cos(phi);
+            float y = glm::sin(theta) * glm::sin(phi);
+            float z = glm::cos(theta);
+
+            // position
+            vertices.push_back(x);
+            vertices.push_back(y);
+            vertices.push_back(z);
+
+            // normal, same as the position on a unit sphere
+            vertices.push_back(x);
+            vertices.push_back(y);
+            vertices.push_back(z);
+        }
+    }
+    // generate indices
+    std::vector<unsigned int> indices;
+    for (int i = 0; i < slices; i++) {
+        for (int j = 0; j < slices; j++) {
+            indices.push_back(i * (slices + 1) + j);
+            indices.push_back((i + 1) * (slices + 1) + j);
+            indices.push_back((i + 1) * (slices + 1) + (j + 1));
+            indices.push_back(i * (slices + 1) + j);
+            indices.push_back((i + 1) * (slices + 1) + (j + 1));
+            indices.push_back(i * (slices + 1) + (j + 1));
+        }
+    }
+    return std::make_shared<const PrimitiveGeometry>(vertices, indices);
+}
+
+std::shared_ptr<const PrimitiveGeometry> PrimitiveCache::buildBox() {
+    // unit cube centered at origin
+    const float w = 0.5f, h = 0.5f, d = 0.5f;
+
+    // define vertices
+    std::vector<float> vertices = {
+        -w, -h,  d,  0.0f, 0.0f, 1.0f,
+         w, -h,  d,  0.0f, 0.0f, 1.0f,
+         w,  h,  d,  0.0f, 0.0f, 1.0f,
+        -w,  h,  d,  0.0f, 0.0f, 1.0f,
+        
+        -w, -h, -d,  0.0f, 0.0f, -1.0f,
+        -w,  h, -d,  0.0f, 0.0f, -1.0f,
+         w,  h, -d,  0.0f, 0.0f, -1.0f,
+         w, -h, -d,  0.0f, 0.0f, -1.0f,
+         
+        -w, -h, -d, -1.0f, 0.0f, 0.0f,
+        -w, -h,  d, -1.0f, 0.0f, 0.0f,
+        -w,  h,  d, -1.0f, 0.0f, 0.0f,
+        -w,  h, -d, -1.0f, 0.0f, 0.0f,
+        
+         w, -h, -d,  1.0f, 0.0f, 0.0f,
+         w,  h, -d,  1.0f, 0.0f, 0.0f,
+         w,  h,  d,  1.0f, 0.0f, 0.0f,
+         w, -h,  d,  1.0f, 0.0f, 0.0f,
+         
+        -w,  h, -d,  0.0f, 1.0f, 0.0f,
+        -w,  h,  d,  0.0f, 1.0f, 0.0f,
+         w,  h,  d,  0.0f, 1.0f, 0.0f,
+         w,  h, -d,  0.0f, 1.0f, 0.0f,
+         
+        -w, -h, -d,  0.0f, -1.0f, 0.0f,
+         w, -h, -d,  0.0f, -1.0f, 0.0f,
+         w, -h,  d,  0.0f, -1.0f, 0.0f,
+        -w, -h,  d,  0.0f, -1.0f, 0.0f,
+    };
+
+    // define indices
+    std::vector<unsigned int> indices = {
+        0, 1, 2, 2, 3, 0,
+        4, 5, 6, 6, 7, 4,
+        8, 9,10,10,11, 8,
+       12,13,14,14,15,12,
+       16,17,18,18,19,16,
+       20,21,22,22,23,20
+    };
+    return std::make_shared<const PrimitiveGeometry>(vertices, indices);
+}
+
+std::shared_ptr<const PrimitiveGeometry> PrimitiveCache::buildCapsule(float height, unsigned int segments, unsigned int rings) {
+    // radius is 1, height is the length of the cylinder part in radii
+    std::vector<float> vertices;
+    std::vector<unsigned int> indices;
+    const float pi = glm::pi<float>();
+
+    for (unsigned int i = 0; i <= segments; ++i) {
+        float theta = i * 2.0f * pi / segments;
+        float cosTheta = cos(theta);
+        float sinTheta = sin(theta);
+
+        for (unsigned int j = 0; j <= rings; ++j) {
+            float y = -height / 2 + j * (height / rings);
+            
+            vertices.push_back(cosTheta);
+            vertices.push_back(y);
+            vertices.push_back(sinTheta);
+            vertices.push_back(cosTheta);
+            vertices.push_back(0.0f);
+            vertices.push_back(sinTheta);
+        }
+    }
+
+    // top and bottom hemispheres
+    for (float side : { 1.0f, -1.0f }) {
+        for (unsigned int i = 0; i <= segments; ++i) {
+            float theta = i * 2.0f * pi / segments;
+            float cosTheta = cos(theta);
+            float sinTheta = sin(theta); 
+            for (unsigned int j = 0; j <= rings; ++j) {
+                float phi = j * pi / (2 * rings);
+                
+                float x_local = sin(phi) * cosTheta;
+                float y_local = side * cos(phi);
+                float z_local = sin(phi) * sinTheta;
+
+                vertices.push_back(x_local);
+                vertices.push_back(y_local + side * height / 2);
+                vertices.push_back(z_local);
+                
+                vertices.push_back(x_local);
+                vertices.push_back(y_local);
+                vertices.push_back(z_local);
+            }
+        }
+    }
+
+    for (unsigned int part = 0; part < 3; ++part) {
+        unsigned int base = part * (segments + 1) * (rings + 1);
+        for (unsigned int i = 0; i < segments; ++i) {
+            for (unsigned int j = 0; j < rings; ++j) {
+                unsigned int first = base + (i * (rings + 1)) + j;
+                unsigned int second = first + rings + 1;
+                indices.push_back(first); indices.push_back(second); indices.push_back(first + 1);
+                indices.push_back(second); indices.push_back(second + 1); indices.push_back(first + 1);
+            }
+        }
+    }
+    return std::make_shared<const PrimitiveGeometry>(vertices, indices);
+}
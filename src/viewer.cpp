@@ -6,11 +6,36 @@
 #include "glm/ext.hpp"
 #include <glm/gtc/matrix_transform.hpp>
 #include "resourceManager.h"
+#include "instancedRenderer.h"
+#include "frameUniforms.h"
+#include "renderQueue.h"
+#include "hitchDetector.h"
 #include "shader.h"
 #include "constants.h"
+#include "gameClock.h"
+#include "nullRenderer.h"
 
 
-Viewer::Viewer(int width, int height)
+Viewer::Viewer(int width, int height, bool headless) : headless(headless)
+{
+    win = nullptr;
+    if (headless) {
+        NullRenderer::Install();
+    } else if (!initWindow(width, height)) {
+        return;
+    }
+
+    // Initialize camera
+    camera = new Camera(glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f), -90.0f, -15.0f);
+    lastX = width / 2.0f;
+    lastY = height / 2.0f;
+    firstMouse = true; 
+
+    // initialize our scene_root
+    scene_root = new Node();
+}
+
+bool Viewer::initWindow(int width, int height)
 {
     if (!glfwInit())    // initialize window system glfw
     {
@@ -40,7 +65,7 @@ Viewer::Viewer(int width, int height)
     {
         std::cerr << "Failed to initialize GLAD" << std::endl;
         glfwTerminate();
-        return;
+        return false;
     }
 
     // Set user pointer for GLFW window to this Viewer instance
@@ -67,15 +92,7 @@ Viewer::Viewer(int width, int height)
     /* with LESS depth-testing interprets a smaller depth value as meaning "closer" */
     glDepthFunc( GL_LESS );
 
-
-    // Initialize camera
-    camera = new Camera(glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f), -90.0f, -15.0f);
-    lastX = width / 2.0f;
-    lastY = height / 2.0f;
-    firstMouse = true; 
-
-    // initialize our scene_root
-    scene_root = new Node();
+    return true;
 }
 
 void Viewer::initShadowMap()
@@ -84,7 +101,7 @@ void Viewer::initShadowMap()
     glGenFramebuffers(1, &depthMapFBO);
 
     glGenTextures(1, &depthMap);
-    glBindTexture(GL_TEXTURE_2D, depthMap);
+    RenderQueue::BindTexture(GL_TEXTURE0, GL_TEXTURE_2D, depthMap);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT, 
                  SHADOW_WIDTH, SHADOW_HEIGHT, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
     
@@ -110,9 +127,11 @@ void Viewer::run()
 
     while (!glfwWindowShouldClose(win))
     {
-        float currentFrame = (float)glfwGetTime();
-        deltaTime = currentFrame - lastFrame;
-        lastFrame = currentFrame;
+        double frameStart = glfwGetTime();
+        deltaTime = tick_callback ? tick_callback() : GameClock::Tick();
+        lastFrame = static_cast<float>(GameClock::Now());
+
+        RenderQueue::ResetStats();
 
         if (update_callback) {
             update_callback();
@@ -122,27 +141,38 @@ void Viewer::run()
         glClearColor(backgroundColor.x, backgroundColor.y, backgroundColor.z, 1.0f);
         glViewport(0, 0, SHADOW_WIDTH, SHADOW_HEIGHT);
 
-        Shader* shader = ResourceManager::GetShader("standard"); 
+        // lit programs: per-shape draws and the instanced path
+        Shader* litShaders[] = { ResourceManager::GetShader("standard"), ResourceManager::GetShader("standardInstanced") };
 
         glm::mat4 lightProjection = glm::ortho(-30.0f, 30.0f, -30.0f, 30.0f, 1.0f, 100.0f);
         glm::mat4 lightView = glm::lookAt(lightPos, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
         glm::mat4 lightSpaceMatrix = lightProjection * lightView;
         glm::mat4 model = glm::mat4(1.0f);
 
+        glm::mat4 view = camera->GetViewMatrix();
+        float aspectRatio = (float) Config::SCR_WIDTH / (float) Config::SCR_HEIGHT;
+        glm::mat4 projection = camera->GetProjectionMatrix(aspectRatio);
+
+        // per-frame uniforms of both passes, uploaded once
+        FrameUniforms::SetPass(FrameUniforms::ShadowPass, lightView, lightProjection, lightSpaceMatrix, camera->Position, lightPos);
+        FrameUniforms::SetPass(FrameUniforms::MainPass, view, projection, lightSpaceMatrix, camera->Position, lightPos);
+        FrameUniforms::Upload();
+
         glViewport(0, 0, SHADOW_WIDTH, SHADOW_HEIGHT);
         glBindFramebuffer(GL_FRAMEBUFFER, depthMapFBO);
         glClear(GL_DEPTH_BUFFER_BIT);
         glEnable(GL_BLEND); 
         glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-        if(shader) {
-            glUseProgram(shader->get_id());
-            glUniform1i(glGetUniformLocation(shader->get_id(), "isShadowPass"), true);
-        }
+        FrameUniforms::Bind(FrameUniforms::ShadowPass);
 
         glCullFace(GL_FRONT);
 
+        // transparent items cast no shadow, only the opaque layer is drawn
+        RenderQueue::Begin(lightPos, lightView, lightProjection);
         scene_root->draw(model, lightView, lightProjection);
+        RenderQueue::Flush(RenderQueue::Opaque);
+        InstancedRenderer::Flush(true);
 
         glCullFace(GL_BACK);
 
@@ -152,23 +182,20 @@ void Viewer::run()
         glViewport(0, 0,Config::SCR_WIDTH,Config::SCR_HEIGHT);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-        if(shader) {
+        FrameUniforms::Bind(FrameUniforms::MainPass);
+
+        RenderQueue::BindTexture(GL_TEXTURE1, GL_TEXTURE_2D, depthMap);
+        for (Shader* shader : litShaders) {
+            if (!shader) continue;
             glUseProgram(shader->get_id());
-            glUniform1i(glGetUniformLocation(shader->get_id(), "isShadowPass"), false);
-
-            glUniform3fv(glGetUniformLocation(shader->get_id(), "viewPos"), 1, &camera->Position[0]);
-            
-            glActiveTexture(GL_TEXTURE1);
-            glBindTexture(GL_TEXTURE_2D, depthMap);
-            glUniform1i(glGetUniformLocation(shader->get_id(), "shadowMap"), 1);
-            glUniformMatrix4fv(glGetUniformLocation(shader->get_id(), "lightSpaceMatrix"), 1, GL_FALSE, &lightSpaceMatrix[0][0]);
-            glUniform3fv(glGetUniformLocation(shader->get_id(), "dirLightPos"), 1, &lightPos[0]);
+            glUniform1i(shader->location(Uniform::ShadowMap), 1);
         }
-        glm::mat4 view = camera->GetViewMatrix();
-        float aspectRatio = (float) Config::SCR_WIDTH / (float) Config::SCR_HEIGHT;
-        glm::mat4 projection = camera->GetProjectionMatrix(aspectRatio);
 
+        RenderQueue::Begin(camera->Position, view, projection);
         scene_root->draw(model, view, projection);
+        RenderQueue::Flush(RenderQueue::Opaque);
+        InstancedRenderer::Flush(false);
+        RenderQueue::Flush(RenderQueue::Transparent);
 
         if (draw_ui_callback) {
             draw_ui_callback();
@@ -177,6 +204,8 @@ void Viewer::run()
         glfwPollEvents();
         glfwSwapBuffers(win);
         glDisable(GL_BLEND);
+
+        HitchDetector::EndFrame((glfwGetTime() - frameStart) * 1000.0);
     }
 
     // cleanup
@@ -252,4 +281,4 @@ void Viewer::mouse_callback(GLFWwindow* window, double xposIn, double yposIn)
     }
 
     viewer->camera->ProcessMouseMovement(xoffset, yoffset);
-}
\ No newline at end of file
+}
\ No newline at end of file